@@ -1,6 +1,8 @@
 #include <iostream>
 #include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include <glcore/Context.h>
+#include <glcore/GpuProfiler.h>
+#include <glcore/StateCache.h>
 
 //The first thing we need to do is write the vertex shader in the shader language GLSL(OpenGL
 //	Shading Language) and then compile this shader so we can use it in our application.
@@ -26,16 +28,14 @@ const char* fragmentShaderSource = "#version 330 core\n" //specify the version o
 
 
 
-int main()
+int main(int argc, char** argv)
 {
-	// Initialize GLFW for window creationz
-	glfwInit();
-	// Tell GLFW that we want to use OpenGL 3.3
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // setting major version
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3); // setting minor version
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // setting profile
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT,
-		GL_TRUE); // setting forward compatibility for Mac
+	//read --headless, --frames and --size from the command line
+	AppOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		return -1;
+	}
 
 	//specify the vertices of the triangle
 	GLfloat vertices[] = {
@@ -56,23 +56,15 @@ int main()
 
 
 
-	GLFWwindow* window = glfwCreateWindow(800, 800, "OpenGL", nullptr, nullptr); // Create a window
-	if (window == nullptr)
+	//Create an OpenGL 3.3 core context, in a window or headless (surfaceless EGL)
+	Context context;
+	if (!context.create(options, "OpenGL")) //the context is current and GLAD has loaded OpenGL once this returns
 	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
 		return -1;
 	}
 
 
-	//tell it that we do like to use the window that we created
-	glfwMakeContextCurrent(window); //Make the window's context current
-
-	//start using colors by telling GLAD to load configuration for OpenGL
-	gladLoadGL(); //Load GLAD so it configures OpenGL
-
-
-	glViewport(0, 0, 800, 800); //Create a viewport of the size of the window
+	glViewport(0, 0, context.getWidth(), context.getHeight()); //Create a viewport of the size of the window
 
 	
 
@@ -187,7 +179,7 @@ int main()
 	glClearColor(0.07f, 0.13f, 0.17f, 1.0f); //Set the color of the window to red
 	glClear(GL_COLOR_BUFFER_BIT); //Clear the color buffer
 
-	glfwSwapBuffers(window); //Swap the buffers to fromt buffer since it where are colors are displayed
+	context.swapBuffers(); //Swap the buffers to fromt buffer since it where are colors are displayed
 
 	//to see out color
 
@@ -197,40 +189,46 @@ int main()
 	/*The glfwWindowShouldClose function checks at the start of each loop iteration if GLFW
 		has been instructed to close.If so, the function returns true and the render loop stops running,
 		after which we can close the application.*/
-	while (!glfwWindowShouldClose(window)) //While the window should not close
+	while (!context.shouldClose()) //While the window should not close, escape also closes it
 	{
-		if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-			glfwSetWindowShouldClose(window, true); //Close the window if the escape key is pressed
 		glClearColor(0.07f, 0.13f, 0.17f, 1.0f); //GlClearColor is a state setting function, setting color
-		glClear(GL_COLOR_BUFFER_BIT); //glClear is a state using function, using the color set by glClearColor
+		{
+			GpuScope gpuScope("clear"); //time the GPU work of this block with --gpu-profile
+			glClear(GL_COLOR_BUFFER_BIT); //glClear is a state using function, using the color set by glClearColor
+		}
 
 		//activate the shader programm
 		/*The processing cores run small programs on the GPU for each step of the
 			pipeline.These small programs are called shaders.*/
-		glUseProgram(shaderProgram); //Use the shader program
-		glBindVertexArray(VAO); //Bind the vertex array object
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		//The state cache only forwards binds that change something, so after the first frame
+		//these two calls cost nothing and the VAO can stay bound between frames
+		getStateCache().useProgram(shaderProgram); //Use the shader program
+		getStateCache().bindVertexArray(VAO); //Bind the vertex array object
+		{
+			GpuScope gpuScope("quad");
+			glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+		}
 		//glDrawArrays(GL_TRIANGLES, 0, 3); //Draw the triangle with 0 offset and 3 vertices
-		glfwSwapBuffers(window); /*The glfwSwapBuffers
+		context.swapBuffers(); /*The glfwSwapBuffers
             will swap the color buffer(a large 2D buffer that contains color values for each pixel in GLFWs
 			window) that is used to render to during this render iteration and show it as output to the screen*/
 
-		glfwPollEvents(); //The glfwPollEvents function checks if any events are
+		context.pollEvents(); //The glfwPollEvents function checks if any events are
 		//triggered(like keyboard input or mouse movement events), updates the window state, and calls the
 		//	corresponding functions(which we can register via callback methods).
 	}
 
 	//1 is passed to the function to specify the number of vertex array objects to delete
+	getStateCache().forgetVertexArray(VAO); //GL may reuse the deleted names, so the cache must forget them
 	glDeleteVertexArrays(1, &VAO); //Delete the vertex array object
+	getStateCache().forgetBuffer(VBO);
 	glDeleteBuffers(1, &VBO); //Delete the buffer
 	glDeleteProgram(shaderProgram); //Delete the shader program
 
 
 	//Once we are done with a window itself we want to delete it
-	glfwDestroyWindow(window); // Destroy the window
-
-	glfwTerminate(); /*As soon as we exit the render loop we would like to properly clean / delete all of GLFWs resources
+	context.destroy(); // Destroy the window (or the headless context)
+	/*As soon as we exit the render loop we would like to properly clean / delete all of GLFWs resources
 		that were allocated.We can do this via the glfwTerminate function that we call at the end of
 		the main function.*/
 }
@@ -1,102 +1,642 @@
 #include <iostream>
 #include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include <glcore/Context.h>
+#include <glcore/CpuProfiler.h>
+#include <glcore/FixedStepper.h>
+#include <glcore/Geometry.h>
+#include <glcore/GeometryCache.h>
+#include <glcore/GpuProfiler.h>
+#include <glcore/Instancing.h>
+#include <glcore/JobSystem.h>
+#include <glcore/Mat4.h>
+#include <glcore/MeshArena.h>
+#include <glcore/Procedural.h>
+#include <glcore/SceneBatcher.h>
+#include <glcore/SnapshotBuffer.h>
+#include <glcore/Shader.h>
+#include <glcore/StateCache.h>
+#include <glcore/StreamBuffer.h>
+#include <glcore/TransformBatch.h>
+#include <glcore/UniformBlocks.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
 #include <vector>
 
-// Function to generate vertices for a circle outline
-std::vector<GLfloat> generateCircleVertices(float centerX, float centerY, float radius, int segments) {
-    std::vector<GLfloat> vertices;
-    for (int i = 0; i < segments; ++i) {
-        float angle = 2.0f * 3.14159f * i / segments;
-        float x = centerX + radius * cos(angle);
-        float y = centerY + radius * sin(angle);
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f); // z-coordinate (0 for 2D shape)
-    }
-    return vertices;
+// Define vertices for two triangles
+static const GLfloat vertices[] = {
+    // First triangle
+    0.0f, 0.5f, 0.0f,
+    -0.5f, -0.5f, 0.0f,
+    0.5f, -0.5f, 0.0f,
+
+    // Second triangle
+    0.0f, 0.5f, 0.0f,
+    0.5f, 0.5f, 0.0f,
+    -0.5f, -0.5f, 0.0f
+};
+
+// One mesh of the instanced scene and the contiguous range of instances that use it
+struct InstanceGroup {
+    GLenum mode;
+    GLint firstVertex;
+    GLsizei vertexCount;
+    int firstInstance;
+    int instanceCount;
+    GLuint program;
+    GLuint VAO;
+};
+
+// Per-instance animation of the instanced scene, kept apart from drawing so it can run on any
+// thread
+struct InstanceAnimation {
+    TransformBatch batch;
+    std::vector<float> spinSpeed;
+    std::vector<float> colorPhase;
+    std::vector<float> phases, sines, cosines;
+    int secondGroup = 0; // first instance of the second triangle
+    int circleGroup = 0; // first circle instance
+};
+
+// Instances animated per job system task; big enough to amortize the task overhead, small enough
+// to balance 100k instances over many cores
+static const int animationGrain = 2048;
+
+// Writes the transforms and colors of every instance at `time`, spread over the job system
+static void animateInstances(InstanceAnimation& animation, JobSystem& jobs, float time, Mat4* transforms, float* colors) {
+    int instanceCount = (int)animation.spinSpeed.size();
+    jobs.parallelFor(0, instanceCount, animationGrain, [&](int begin, int end) {
+        // Transforms for the range in one batched pass
+        for (int i = begin; i < end; ++i) {
+            animation.batch.angle[i] = time * animation.spinSpeed[i];
+        }
+        computeTransforms(animation.batch, transforms, begin, end);
+
+        // Colors pulse like the original triangles, offset per instance
+        for (int i = begin; i < end; ++i) {
+            animation.phases[i] = time * 2.0f + animation.colorPhase[i];
+        }
+        sinCos(&animation.phases[begin], &animation.sines[begin], &animation.cosines[begin], end - begin);
+        for (int i = begin; i < end; ++i) {
+            float pulse = (animation.sines[i] + 1.0f) / 2.0f;
+            float* color = &colors[i * 4];
+            if (i < animation.secondGroup) {
+                color[0] = pulse; color[1] = 0.3f; color[2] = 0.5f; color[3] = 1.0f;
+            }
+            else if (i < animation.circleGroup) {
+                color[0] = 0.3f; color[1] = pulse; color[2] = 0.8f; color[3] = 1.0f;
+            }
+            else {
+                color[0] = 1.0f; color[1] = 1.0f; color[2] = 1.0f; color[3] = 1.0f;
+            }
+        }
+    });
 }
 
+// Everything the render thread needs to draw one frame of the instanced scene
+struct InstanceSnapshot {
+    float time = 0.0f;
+    std::vector<Mat4> transforms;
+    std::vector<float> colors;
+};
+
+// Instanced stress scene: instanceCount shapes on a grid, cycling through the two triangles and
+// the circle of the original scene. Per-instance transforms and colors are recomputed each frame
+// straight into a streaming ring buffer, then each mesh is drawn with one glDrawArraysInstanced.
+// Circles are analytic rings on one quad each rather than tessellated line loops.
+//
+// With --render-thread the main thread only animates, into a SnapshotBuffer, and a render thread
+// that owns the context copies each snapshot into the stream and draws it. The two overlap, so a
+// frame costs the slower of animation and submission instead of both.
+static int runInstancedScene(Context& context, const AppOptions& options) {
+    int instanceCount = options.instances;
+    GLuint shaderProgram = createShaderProgram(instancedVertexShaderSource, vertexColorFragmentShaderSource);
+    GLuint circleProgram = createShaderProgram(circleVertexShaderSource, circleFragmentShaderSource);
+    if (shaderProgram == 0 || circleProgram == 0) {
+        glDeleteProgram(shaderProgram);
+        glDeleteProgram(circleProgram);
+        return -1;
+    }
 
-const char* vertexShaderSource = "#version 330 core\n"
-"layout(location = 0) in vec3 aPos;\n"
-"uniform mat4 transform;\n"
-"void main()\n"
-"{\n"
-"   gl_Position = transform * vec4(aPos, 1.0);\n"
-"}\0";
+    GLuint meshVBO;
+    glGenBuffers(1, &meshVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-const char* fragmentShaderSource = "#version 330 core\n"
-"out vec4 FragColor;\n"
-"uniform vec4 color;\n"
-"void main()\n"
-"{\n"
-"   FragColor = color;\n"
-"}\n\0";
+    // Frame constants: the circle quads need the pixel size for their anti-aliased edge.
+    // Transforms and colors of every instance are streamed each frame.
+    GLsizeiptr transformBytes = instanceCount * sizeof(Mat4);
+    GLsizeiptr colorBytes = instanceCount * 4 * sizeof(float);
+    UniformStream uniforms;
+    StreamBuffer instanceStream;
+    if (!uniforms.create(0, !options.orphanStreams)
+        || !instanceStream.create(transformBytes + colorBytes + 16, 3, !options.orphanStreams)) {
+        getStateCache().forgetBuffer(meshVBO);
+        glDeleteBuffers(1, &meshVBO);
+        glDeleteProgram(shaderProgram);
+        glDeleteProgram(circleProgram);
+        return -1;
+    }
 
+    // Instances are sorted by mesh so every group is one contiguous range of the instance buffers
+    int perGroup = instanceCount / 3;
+    InstanceGroup groups[3] = {
+        { GL_TRIANGLES, 0, 3, 0, perGroup + (instanceCount % 3 > 0 ? 1 : 0), shaderProgram, 0 },
+        { GL_TRIANGLES, 3, 3, 0, perGroup + (instanceCount % 3 > 1 ? 1 : 0), shaderProgram, 0 },
+        { GL_TRIANGLE_STRIP, 0, circleQuadVertexCount, 0, perGroup, circleProgram, 0 }
+    };
+    groups[1].firstInstance = groups[0].instanceCount;
+    groups[2].firstInstance = groups[1].firstInstance + groups[1].instanceCount;
+
+    // Circle outlines of the original size (radius 0.3), a little thicker than a line so they stay
+    // visible once scaled down to a grid cell
+    std::vector<float> circleShapes(groups[2].instanceCount * 2);
+    for (int i = 0; i < groups[2].instanceCount; ++i) {
+        circleShapes[i * 2 + 0] = 0.3f;
+        circleShapes[i * 2 + 1] = 0.02f;
+    }
+    GLuint circleShapeVBO;
+    glGenBuffers(1, &circleShapeVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, circleShapeVBO);
+    glBufferData(GL_ARRAY_BUFFER, circleShapes.size() * sizeof(float), circleShapes.data(), GL_STATIC_DRAW);
+
+    // One VAO per group; the instance attributes are pointed at the group's range every frame.
+    // The circle quads have no mesh, their corners come from gl_VertexID.
+    for (InstanceGroup& group : groups) {
+        glGenVertexArrays(1, &group.VAO);
+        glBindVertexArray(group.VAO);
+        if (group.program == shaderProgram) {
+            glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+            glEnableVertexAttribArray(0);
+        }
+        else {
+            bindInstanceCircles(circleShapeVBO, 0);
+        }
+    }
+    glBindVertexArray(0);
+    getStateCache().invalidate();
+
+    // Circle edges are blended over the background; the triangles are opaque and unaffected
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Lay the instances out on a square grid, interleaving the three meshes
+    int columns = (int)std::ceil(std::sqrt((float)instanceCount));
+    float cellSize = 2.0f / columns;
+    InstanceAnimation animation;
+    animation.batch.resize(instanceCount);
+    animation.spinSpeed.resize(instanceCount);
+    animation.colorPhase.resize(instanceCount);
+    animation.phases.resize(instanceCount);
+    animation.sines.resize(instanceCount);
+    animation.cosines.resize(instanceCount);
+    animation.secondGroup = groups[1].firstInstance;
+    animation.circleGroup = groups[2].firstInstance;
+    for (int g = 0; g < 3; ++g) {
+        for (int j = 0; j < groups[g].instanceCount; ++j) {
+            int i = groups[g].firstInstance + j;
+            int cell = j * 3 + g;
+            animation.batch.x[i] = -1.0f + cellSize * (cell % columns + 0.5f);
+            animation.batch.y[i] = 1.0f - cellSize * (cell / columns + 0.5f);
+            animation.batch.scale[i] = cellSize * 0.9f;
+            animation.spinSpeed[i] = (g == 0) ? 50.0f : (g == 1 ? -50.0f : 0.0f);
+            animation.colorPhase[i] = 0.37f * cell;
+        }
+    }
 
+    // Animation is spread over --threads threads, one per core by default
+    JobSystem jobs(options.threads);
+    std::cout << "Animating " << instanceCount << " instances on " << jobs.getThreadCount() << " thread(s)" << std::endl;
 
-// Function to create rotation matrix
-void createRotationMatrix(float* matrix, float angle) {
-    float rad = angle * 3.14159f / 180.0f;
-    float cosA = cos(rad);
-    float sinA = sin(rad);
+    // Draws one frame at `time`; animate fills the instance data straight into the stream
+    auto renderFrame = [&](float time, const std::function<void(Mat4*, float*)>& animate) {
+        float bgRed = (sin(time * 0.5f) + 1.0f) / 2.0f;
+        float bgGreen = (cos(time * 0.3f) + 1.0f) / 2.0f;
+        float bgBlue = (sin(time * 0.7f) + 1.0f) / 2.0f;
+        glClearColor(bgRed, bgGreen, bgBlue, 1.0f);
+        {
+            GpuScope scope("clear");
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        if (!uniforms.beginFrame(0)) {
+            return false;
+        }
+        FrameUniforms& frame = uniforms.getFrame();
+        setMatrix(frame.viewProjection, Mat4::identity());
+        setColor(frame.background, bgRed, bgGreen, bgBlue, 1.0f);
+        frame.time = time;
+        frame.pixelSize[0] = 2.0f / context.getWidth();
+        frame.pixelSize[1] = 2.0f / context.getHeight();
+        uniforms.flush();
+
+        // Write this frame's instance data directly into the next region of the stream
+        GLintptr transformOffset = 0, colorOffset = 0;
+        {
+            CpuScope scope("instance upload");
+            instanceStream.beginFrame();
+            Mat4* transforms = (Mat4*)instanceStream.allocate(transformBytes, transformOffset);
+            float* colors = (float*)instanceStream.allocate(colorBytes, colorOffset);
+            if (transforms == nullptr || colors == nullptr) {
+                std::cout << "ERROR::INSTANCED_SCENE::STREAM_FULL (" << instanceCount << " instances)" << std::endl;
+                return false;
+            }
+            animate(transforms, colors);
+            instanceStream.flush();
+        }
+
+        {
+            CpuScope scope("draw submission");
+            StateCache& state = getStateCache();
+            for (const InstanceGroup& group : groups) {
+                if (group.instanceCount > 0) {
+                    state.useProgram(group.program);
+                    state.bindVertexArray(group.VAO);
+                    bindInstanceTransforms(instanceStream.getBuffer(), transformOffset + group.firstInstance * sizeof(Mat4));
+                    bindInstanceColors(instanceStream.getBuffer(), colorOffset + group.firstInstance * 4 * sizeof(float));
+                    GpuScope gpuScope(group.program == shaderProgram ? "instanced triangles" : "instanced circles");
+                    glDrawArraysInstanced(group.mode, group.firstVertex, group.vertexCount, group.instanceCount);
+                }
+            }
+        }
 
-    matrix[0] = cosA; matrix[1] = -sinA; matrix[2] = 0.0f; matrix[3] = 0.0f;
-    matrix[4] = sinA; matrix[5] = cosA;  matrix[6] = 0.0f; matrix[7] = 0.0f;
-    matrix[8] = 0.0f; matrix[9] = 0.0f;  matrix[10] = 1.0f; matrix[11] = 0.0f;
-    matrix[12] = 0.0f; matrix[13] = 0.0f; matrix[14] = 0.0f; matrix[15] = 1.0f;
+        context.swapBuffers();
+        return true;
+    };
+
+    bool failed = false;
+    if (options.renderThread) {
+        SnapshotBuffer<InstanceSnapshot> snapshots;
+        std::atomic<bool> animationDone{ false };
+        std::atomic<bool> renderFailed{ false }; // the render thread stopped taking snapshots
+        double animateSeconds = 0.0, renderSeconds = 0.0;
+        int published = 0, rendered = 0;
+
+        // The render thread owns the context until the main thread has published its last frame
+        context.releaseCurrent();
+        std::thread renderThread([&]() {
+            CpuProfiler::setThreadName("render");
+            context.makeCurrent();
+            for (;;) {
+                const InstanceSnapshot* snapshot = snapshots.acquire();
+                if (snapshot == nullptr) {
+                    // Check for a last snapshot published just before the main thread finished
+                    if (animationDone.load(std::memory_order_acquire)) {
+                        snapshot = snapshots.acquire();
+                        if (snapshot == nullptr) {
+                            break;
+                        }
+                    }
+                    else {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                }
+                double start = context.getClock().getElapsed();
+                bool ok = renderFrame(snapshot->time, [&](Mat4* transforms, float* colors) {
+                    std::memcpy(transforms, snapshot->transforms.data(), transformBytes);
+                    std::memcpy(colors, snapshot->colors.data(), colorBytes);
+                });
+                renderSeconds += context.getClock().getElapsed() - start;
+                ++rendered;
+                if (!ok) {
+                    renderFailed.store(true, std::memory_order_release);
+                    break;
+                }
+            }
+            context.releaseCurrent();
+        });
+
+        // Animate frame N + 1 while frame N renders. Waiting for the render thread to take the
+        // pending snapshot before publishing keeps every frame and stops the animation from
+        // running ahead of what is drawn.
+        while (!context.shouldClose() && !renderFailed.load(std::memory_order_acquire)
+            && (options.frames == 0 || published < options.frames)) {
+            context.pollEvents();
+
+            // Frame time by number: the render thread's frame count lags behind the snapshots
+            double start = context.getClock().getElapsed();
+            InstanceSnapshot& snapshot = snapshots.beginWrite();
+            snapshot.time = (float)context.getClock().getFrameTime(published);
+            snapshot.transforms.resize(instanceCount);
+            snapshot.colors.resize(instanceCount * 4);
+            {
+                CpuScope scope("animation");
+                animateInstances(animation, jobs, snapshot.time, snapshot.transforms.data(), snapshot.colors.data());
+            }
+            animateSeconds += context.getClock().getElapsed() - start;
+
+            CpuScope wait("wait for render thread");
+            while (snapshots.isPending() && !context.shouldClose() && !renderFailed.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            snapshots.publish();
+            ++published;
+        }
+        animationDone.store(true, std::memory_order_release);
+        renderThread.join();
+        context.makeCurrent();
+        failed = renderFailed.load(std::memory_order_relaxed);
+
+        std::cout << "Render thread: " << rendered << " frames, animation " << animateSeconds * 1000.0 / std::max(published, 1)
+            << " ms and rendering " << renderSeconds * 1000.0 / std::max(rendered, 1) << " ms per frame, overlapped" << std::endl;
+    }
+    else {
+        while (!context.shouldClose()) {
+            context.pollEvents();
+
+            float time = (float)context.getTime();
+            bool ok = renderFrame(time, [&](Mat4* transforms, float* colors) {
+                CpuScope scope("animation");
+                animateInstances(animation, jobs, time, transforms, colors);
+            });
+            if (!ok) {
+                failed = true;
+                break;
+            }
+        }
+    }
+
+    for (InstanceGroup& group : groups) {
+        getStateCache().forgetVertexArray(group.VAO);
+        glDeleteVertexArrays(1, &group.VAO);
+    }
+    const StreamStats& stats = instanceStream.getStats();
+    std::cout << "Streamed " << stats.totalBytes / (1024.0 * 1024.0) << " MB in " << stats.frames << " frames ("
+        << (instanceStream.isPersistent() ? "persistent mapping" : "orphaning") << "), "
+        << stats.totalWaits << " fence waits" << std::endl;
+
+    uniforms.destroy();
+    instanceStream.destroy();
+    getStateCache().forgetBuffer(meshVBO);
+    glDeleteBuffers(1, &meshVBO);
+    getStateCache().forgetBuffer(circleShapeVBO);
+    glDeleteBuffers(1, &circleShapeVBO);
+    glDeleteProgram(shaderProgram);
+    glDeleteProgram(circleProgram);
+    context.destroy();
+    return failed ? -1 : 0;
+}
+
+// Moving parts of the original scene, advanced in fixed simulation ticks
+struct SceneState {
+    float spin = 0.0f;  // degrees, kept in [0, 360); the triangles turn opposite ways
+    float pulse = 0.5f; // color pulse in [0, 1]
+};
+
+// Advances the scene by one tick of dt seconds, ending at simulation time `time`
+static void updateScene(SceneState& state, float time, float dt) {
+    state.spin = std::fmod(state.spin + 50.0f * dt, 360.0f);
+    state.pulse = (sin(time * 2.0f) + 1.0f) / 2.0f;
 }
 
-// Function to create translation matrix
-void createTranslationMatrix(float* matrix, float x, float y, float z) {
-    matrix[0] = 1.0f; matrix[1] = 0.0f; matrix[2] = 0.0f; matrix[3] = x;
-    matrix[4] = 0.0f; matrix[5] = 1.0f; matrix[6] = 0.0f; matrix[7] = y;
-    matrix[8] = 0.0f; matrix[9] = 0.0f; matrix[10] = 1.0f; matrix[11] = z;
-    matrix[12] = 0.0f; matrix[13] = 0.0f; matrix[14] = 0.0f; matrix[15] = 1.0f;
+// State to render, alpha of the way from the previous tick to the current one
+static SceneState interpolateScene(const SceneState& previous, const SceneState& current, float alpha) {
+    SceneState state;
+    state.spin = lerpAngle(previous.spin, current.spin, alpha);
+    state.pulse = lerp(previous.pulse, current.pulse, alpha);
+    return state;
 }
 
-void multiplyMatrices(const float* a, const float* b, float* result) {
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            result[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] +
-                a[i * 4 + 1] * b[1 * 4 + j] +
-                a[i * 4 + 2] * b[2 * 4 + j] +
-                a[i * 4 + 3] * b[3 * 4 + j];
+// Deterministic value in [0, 1) for item i, so scenes lay out the same on every run
+static float hashUnit(int i, int salt) {
+    unsigned int h = (unsigned int)i * 747796405u + (unsigned int)salt * 2891336453u;
+    h = ((h >> ((h >> 28) + 4)) ^ h) * 277803737u;
+    h = (h >> 22) ^ h;
+    return (h & 0xFFFFFF) / 16777216.0f;
+}
+
+// Circle field: circleCount tessellated outlines of a few radii drifting across the screen. Each
+// outline gets the fewest segments that keep it within half a pixel of a true circle at the
+// current framebuffer size, so tiny circles cost 8 vertices. The outlines come from a
+// GeometryCache, so each LOD is generated and uploaded once however many circles use it, and the
+// whole field goes through a SceneBatcher.
+static int runCircleScene(Context& context, const AppOptions& options) {
+    int circleCount = options.circles;
+    GLuint shaderProgram = createShaderProgram(batchVertexShaderSource, vertexColorFragmentShaderSource);
+    if (shaderProgram == 0) {
+        return -1;
+    }
+
+    static const float radii[] = { 0.006f, 0.02f, 0.05f, 0.12f };
+    float pixelsPerUnit = 0.5f * std::min(context.getWidth(), context.getHeight());
+
+    MeshArena arena;
+    GeometryCache cache(arena);
+    std::vector<MeshRange> meshes(circleCount);
+    std::vector<float> startX(circleCount), startY(circleCount), speed(circleCount), hue(circleCount);
+    for (int i = 0; i < circleCount; ++i) {
+        meshes[i] = cache.getAdaptiveCircle(radii[i % 4], radii[i % 4] * pixelsPerUnit);
+        startX[i] = hashUnit(i, 1) * 2.0f;
+        startY[i] = hashUnit(i, 2) * 2.0f - 1.0f;
+        speed[i] = 0.05f + hashUnit(i, 3) * 0.2f;
+        hue[i] = hashUnit(i, 4) * 6.28318f;
+    }
+    cache.flush();
+    long long vertexCount = 0;
+    for (const MeshRange& mesh : meshes) {
+        vertexCount += mesh.vertexCount;
+    }
+    std::cout << "Geometry cache: " << cache.getMisses() << " meshes for " << cache.getHits() + cache.getMisses()
+        << " circles (" << cache.getHitRate() * 100.0 << "% hits), " << cache.getUploads() << " upload(s), "
+        << vertexCount << " vertices per frame" << std::endl;
+
+    SceneBatcher batcher;
+    UniformStream uniforms;
+    if (!batcher.create(arena, circleCount, !options.orphanStreams, options.indirectDraws)
+        || !uniforms.create(0, !options.orphanStreams)) {
+        glDeleteProgram(shaderProgram);
+        return -1;
+    }
+
+    while (!context.shouldClose()) {
+        context.pollEvents();
+
+        float time = (float)context.getTime();
+        float bgRed = (sin(time * 0.5f) + 1.0f) / 2.0f * 0.2f;
+        float bgGreen = (cos(time * 0.3f) + 1.0f) / 2.0f * 0.2f;
+        float bgBlue = (sin(time * 0.7f) + 1.0f) / 2.0f * 0.2f;
+        glClearColor(bgRed, bgGreen, bgBlue, 1.0f);
+        {
+            GpuScope scope("clear");
+            glClear(GL_COLOR_BUFFER_BIT);
         }
+
+        if (!uniforms.beginFrame(0)) {
+            break;
+        }
+        FrameUniforms& frame = uniforms.getFrame();
+        setMatrix(frame.viewProjection, Mat4::identity());
+        setColor(frame.background, bgRed, bgGreen, bgBlue, 1.0f);
+        frame.time = time;
+        frame.pixelSize[0] = 2.0f / context.getWidth();
+        frame.pixelSize[1] = 2.0f / context.getHeight();
+        uniforms.flush();
+
+        // Circles drift to the right and wrap around. The batch shader applies transforms like the
+        // original uniform path (transposed), so the translation is transposed to move the circle.
+        {
+            CpuScope scope("animation");
+            batcher.begin();
+            for (int i = 0; i < circleCount; ++i) {
+                float x = std::fmod(startX[i] + speed[i] * time, 2.0f) - 1.0f;
+                DrawRecord record = {};
+                setMatrix(record.transform, transpose(translation(x, startY[i], 0.0f)));
+                setColor(record.color, (sin(hue[i]) + 1.0f) / 2.0f, (sin(hue[i] + 2.1f) + 1.0f) / 2.0f, (sin(hue[i] + 4.2f) + 1.0f) / 2.0f, 1.0f);
+                batcher.add(GL_LINE_LOOP, meshes[i], record);
+            }
+        }
+        {
+            CpuScope scope("draw submission");
+            getStateCache().useProgram(shaderProgram);
+            if (!batcher.submit()) {
+                break;
+            }
+        }
+
+        context.swapBuffers();
     }
+
+    uniforms.destroy();
+    batcher.destroy();
+    arena.destroy();
+    glDeleteProgram(shaderProgram);
+    context.destroy();
+    return 0;
 }
 
-int main() {
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+// Procedural scene: shapeCount triangles, quads and circles spinning on a grid, all generated in
+// the vertex shader from one static buffer of instance records, with no vertex buffer at all.
+// Records are sorted by side count and each count is drawn with one glDrawArraysInstanced.
+static int runProceduralScene(Context& context, const AppOptions& options) {
+    int shapeCount = options.procedural;
+    GLuint shaderProgram = createShaderProgram(proceduralVertexShaderSource, vertexColorFragmentShaderSource);
+    if (shaderProgram == 0) {
+        return -1;
+    }
+
+    int columns = (int)std::ceil(std::sqrt((float)shapeCount));
+    float cellSize = 2.0f / columns;
+    float radiusPixels = 0.45f * cellSize * 0.5f * std::min(context.getWidth(), context.getHeight());
+    int circleSegments = adaptiveCircleSegments(radiusPixels);
+
+    std::vector<ProceduralShape> shapes(shapeCount);
+    for (int i = 0; i < shapeCount; ++i) {
+        ProceduralShape& shape = shapes[i];
+        shape = ProceduralShape();
+        shape.centerX = -1.0f + cellSize * (i % columns + 0.5f);
+        shape.centerY = 1.0f - cellSize * (i / columns + 0.5f);
+        shape.radius = cellSize * 0.45f;
+        shape.angle = 90.0f;
+        shape.segments = (i % 3 == 0) ? 3.0f : (i % 3 == 1 ? 4.0f : (float)circleSegments);
+        shape.spin = (i % 3 == 0) ? 50.0f : (i % 3 == 1 ? -50.0f : 0.0f);
+        float hue = hashUnit(i, 4) * 6.28318f;
+        setColor(shape.color, (sin(hue) + 1.0f) / 2.0f, (sin(hue + 2.1f) + 1.0f) / 2.0f, (sin(hue + 4.2f) + 1.0f) / 2.0f, 1.0f);
+    }
+    std::stable_sort(shapes.begin(), shapes.end(), [](const ProceduralShape& a, const ProceduralShape& b) {
+        return a.segments < b.segments;
+    });
 
-    GLFWwindow* window = glfwCreateWindow(800, 800, "OpenGL Shapes Tranforming", nullptr, nullptr);
-    if (window == nullptr) {
-        std::cout << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
+    GLuint shapeVBO, VAO;
+    glGenBuffers(1, &shapeVBO);
+    glGenVertexArrays(1, &VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, shapeVBO);
+    glBufferData(GL_ARRAY_BUFFER, shapes.size() * sizeof(ProceduralShape), shapes.data(), GL_STATIC_DRAW);
+
+    UniformStream uniforms;
+    if (!uniforms.create(0, !options.orphanStreams)) {
+        getStateCache().forgetBuffer(shapeVBO);
+        glDeleteBuffers(1, &shapeVBO);
+        getStateCache().forgetVertexArray(VAO);
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteProgram(shaderProgram);
         return -1;
     }
-    glfwMakeContextCurrent(window);
-    gladLoadGL();
+    std::cout << "Procedural shapes: " << shapeCount << " from " << shapes.size() * sizeof(ProceduralShape) / 1024.0
+        << " KB of instance records, no vertex buffers, circles with " << circleSegments << " segments" << std::endl;
+
+    StateCache& state = getStateCache();
+    while (!context.shouldClose()) {
+        context.pollEvents();
 
-    glViewport(0, 0, 800, 800);
+        float time = (float)context.getTime();
+        float bgRed = (sin(time * 0.5f) + 1.0f) / 2.0f;
+        float bgGreen = (cos(time * 0.3f) + 1.0f) / 2.0f;
+        float bgBlue = (sin(time * 0.7f) + 1.0f) / 2.0f;
+        glClearColor(bgRed, bgGreen, bgBlue, 1.0f);
+        {
+            GpuScope scope("clear");
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
 
-    // Define vertices for two triangles
-    GLfloat vertices[] = {
-        // First triangle
-        0.0f, 0.5f, 0.0f,
-        -0.5f, -0.5f, 0.0f,
-        0.5f, -0.5f, 0.0f,
+        if (!uniforms.beginFrame(0)) {
+            break;
+        }
+        FrameUniforms& frame = uniforms.getFrame();
+        setMatrix(frame.viewProjection, Mat4::identity());
+        setColor(frame.background, bgRed, bgGreen, bgBlue, 1.0f);
+        frame.time = time;
+        frame.pixelSize[0] = 2.0f / context.getWidth();
+        frame.pixelSize[1] = 2.0f / context.getHeight();
+        uniforms.flush();
+
+        {
+            CpuScope scope("draw submission");
+            state.useProgram(shaderProgram);
+            state.bindVertexArray(VAO);
+            int first = 0;
+            while (first < shapeCount) {
+                int last = first;
+                while (last < shapeCount && shapes[last].segments == shapes[first].segments) {
+                    ++last;
+                }
+                bindProceduralShapes(shapeVBO, first * sizeof(ProceduralShape));
+                GpuScope gpuScope("procedural shapes");
+                glDrawArraysInstanced(GL_TRIANGLES, 0, proceduralVertexCount((int)shapes[first].segments), last - first);
+                first = last;
+            }
+        }
 
-        // Second triangle
-        0.0f, 0.5f, 0.0f,
-        0.5f, 0.5f, 0.0f,
-        -0.5f, -0.5f, 0.0f
-    };
+        context.swapBuffers();
+    }
+
+    uniforms.destroy();
+    getStateCache().forgetVertexArray(VAO);
+    glDeleteVertexArrays(1, &VAO);
+    getStateCache().forgetBuffer(shapeVBO);
+    glDeleteBuffers(1, &shapeVBO);
+    glDeleteProgram(shaderProgram);
+    context.destroy();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    AppOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return -1;
+    }
+
+    // Window, or a surfaceless EGL context with --headless
+    Context context;
+    if (!context.create(options, "OpenGL Shapes Tranforming")) {
+        return -1;
+    }
+
+    glViewport(0, 0, context.getWidth(), context.getHeight());
+
+    if (options.instances > 0) {
+        return runInstancedScene(context, options);
+    }
+    if (options.circles > 0) {
+        return runCircleScene(context, options);
+    }
+    if (options.procedural > 0) {
+        return runProceduralScene(context, options);
+    }
 
     // Generate circle vertices (e.g., radius 0.3, 50 segments for smoothness)
     std::vector<GLfloat> circleVertices = generateCircleVertices(0.0f, 0.0f, 0.3f, 50);
@@ -117,21 +657,10 @@ int main() {
 
 
     // Compile shaders
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    GLuint shaderProgram = createShaderProgram(transformVertexShaderSource, colorFragmentShaderSource);
+    if (shaderProgram == 0) {
+        return -1;
+    }
 
     // Setup buffers
     GLuint VAO, VBO;
@@ -145,66 +674,115 @@ int main() {
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    GLuint transformLoc = glGetUniformLocation(shaderProgram, "transform");
-    GLuint colorLoc = glGetUniformLocation(shaderProgram, "color");
-
-    while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+    // Frame constants and the three draws' transforms and colors, streamed once per frame
+    UniformStream uniforms;
+    if (!uniforms.create(3, !options.orphanStreams)) {
+        return -1;
+    }
+    StateCache& state = getStateCache();
+
+    // The simulation runs at a fixed tick rate; frames render a blend of the last two ticks
+    FixedStepper stepper(1.0 / options.tickRate);
+    SceneState previousScene, currentScene;
+    updateScene(currentScene, 0.0f, 0.0f);
+    previousScene = currentScene;
+    double simulationTime = 0.0;
+    stepper.reset(context.getTime());
+
+    while (!context.shouldClose()) {
+        context.pollEvents();
+
+        SceneState scene;
+        {
+            CpuScope scope("animation");
+            int ticks = stepper.advance(context.getTime());
+            for (int i = 0; i < ticks; ++i) {
+                previousScene = currentScene;
+                simulationTime += stepper.getStep();
+                updateScene(currentScene, (float)simulationTime, (float)stepper.getStep());
+            }
+            scene = interpolateScene(previousScene, currentScene, stepper.getAlpha());
+        }
 
         // Calculate background color based on time
-        float time = (float)glfwGetTime();
+        float time = (float)stepper.getRenderTime();
         float bgRed = (sin(time * 0.5f) + 1.0f) / 2.0f;
         float bgGreen = (cos(time * 0.3f) + 1.0f) / 2.0f;
         float bgBlue = (sin(time * 0.7f) + 1.0f) / 2.0f;
 
         // Set dynamic background color
         glClearColor(bgRed, bgGreen, bgBlue, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        // Use shader program for shapes
-        glUseProgram(shaderProgram);
-
-        // Render first triangle
-        float rotationMatrix[16];
-        float translationMatrix[16];
-        float finalMatrix[16];
+        {
+            GpuScope scope("clear");
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
 
-        createRotationMatrix(rotationMatrix, time * 50.0f);
-        createTranslationMatrix(translationMatrix, -0.5f, 0.0f, 0.0f);
-        multiplyMatrices(translationMatrix, rotationMatrix, finalMatrix);
+        // Write this frame's uniforms in one pass
+        {
+            CpuScope scope("uploads");
+            if (!uniforms.beginFrame(3)) {
+                break;
+            }
+            FrameUniforms& frame = uniforms.getFrame();
+            setMatrix(frame.viewProjection, Mat4::identity());
+            setColor(frame.background, bgRed, bgGreen, bgBlue, 1.0f);
+            frame.time = time;
+
+            // First triangle, translation * rotation built in one step
+            DrawUniforms& first = uniforms.getDraw(0);
+            Mat4 finalMatrix = translateRotateZ(-0.5f, 0.0f, 0.0f, scene.spin);
+            setMatrix(first.transform, finalMatrix);
+            setColor(first.color, scene.pulse, 0.3f, 0.5f, 1.0f);
+
+            // Second triangle with a different transformation
+            DrawUniforms& second = uniforms.getDraw(1);
+            finalMatrix = translateRotateZ(0.5f, 0.0f, 0.0f, -scene.spin);
+            setMatrix(second.transform, finalMatrix);
+            setColor(second.color, 0.3f, scene.pulse, 0.8f, 1.0f);
+
+            // Circle outline in white, riding along with the second triangle's transform
+            DrawUniforms& circle = uniforms.getDraw(2);
+            setMatrix(circle.transform, finalMatrix);
+            setColor(circle.color, 1.0f, 1.0f, 1.0f, 1.0f);
+
+            uniforms.flush();
+        }
 
-        glUniformMatrix4fv(transformLoc, 1, GL_FALSE, finalMatrix);
-        glUniform4f(colorLoc, (sin(time * 2.0f) + 1.0f) / 2.0f, 0.3f, 0.5f, 1.0f);
-        glBindVertexArray(VAO);  // Triangle VAO
-        glDrawArrays(GL_TRIANGLES, 0, 3);
+        {
+            CpuScope scope("draw submission");
 
-        // Render second triangle with a different transformation
-        createRotationMatrix(rotationMatrix, -time * 50.0f);
-        createTranslationMatrix(translationMatrix, 0.5f, 0.0f, 0.0f);
-        multiplyMatrices(translationMatrix, rotationMatrix, finalMatrix);
+            // Use shader program for shapes
+            state.useProgram(shaderProgram);
 
-        glUniformMatrix4fv(transformLoc, 1, GL_FALSE, finalMatrix);
-        glUniform4f(colorLoc, 0.3f, (sin(time * 2.0f) + 1.0f) / 2.0f, 0.8f, 1.0f);
-        glDrawArrays(GL_TRIANGLES, 3, 3);
+            {
+                GpuScope gpuScope("triangles");
+                uniforms.bindDraw(0);
+                state.bindVertexArray(VAO);  // Triangle VAO
+                glDrawArrays(GL_TRIANGLES, 0, 3);
 
-        // Render circle outline
-        glBindVertexArray(circleVAO);  // Circle VAO
-        glUniform4f(colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);  // Circle color (e.g., white)
-        glDrawArrays(GL_LINE_LOOP, 0, circleVertices.size() / 3);
+                uniforms.bindDraw(1);
+                glDrawArrays(GL_TRIANGLES, 3, 3);
+            }
 
-        // Unbind VAO
-        glBindVertexArray(0);
+            {
+                GpuScope gpuScope("circle");
+                uniforms.bindDraw(2);
+                state.bindVertexArray(circleVAO);  // Circle VAO
+                glDrawArrays(GL_LINE_LOOP, 0, circleVertices.size() / 3);
+            }
+        }
 
         // Swap buffers to display the rendered frame
-        glfwSwapBuffers(window);
+        context.swapBuffers();
     }
 
 
 
+    getStateCache().forgetVertexArray(VAO);
     glDeleteVertexArrays(1, &VAO);
+    getStateCache().forgetBuffer(VBO);
     glDeleteBuffers(1, &VBO);
     glDeleteProgram(shaderProgram);
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    context.destroy();
     return 0;
 }
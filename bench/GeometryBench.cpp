@@ -0,0 +1,41 @@
+// Circle tessellation at the segment counts the adaptive LOD picks from, and the CPU vertex
+// interpolation of the morphing shapes, reported per vertex.
+
+#include <benchmark/benchmark.h>
+
+#include <glcore/Geometry.h>
+
+#include <random>
+#include <vector>
+
+static void BM_GenerateCircleVertices(benchmark::State& state) {
+    int segments = (int)state.range(0);
+    for (auto _ : state) {
+        std::vector<GLfloat> vertices = generateCircleVertices(0.25f, -0.25f, 0.5f, segments);
+        benchmark::DoNotOptimize(vertices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * segments);
+}
+BENCHMARK(BM_GenerateCircleVertices)->RangeMultiplier(4)->Range(minAdaptiveSegments, 2048);
+
+static void BM_InterpolateVertices(benchmark::State& state) {
+    int vertexCount = (int)state.range(0);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<GLfloat> start(vertexCount * 3), end(vertexCount * 3), result(vertexCount * 3);
+    for (int i = 0; i < vertexCount * 3; ++i) {
+        start[i] = dist(rng);
+        end[i] = dist(rng);
+    }
+    float t = 0.0f;
+    for (auto _ : state) {
+        interpolateVertices(start.data(), end.data(), result.data(), t, vertexCount);
+        t = t < 1.0f ? t + 0.01f : 0.0f;
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+    state.SetBytesProcessed(state.iterations() * vertexCount * 3 * (int64_t)sizeof(GLfloat));
+}
+BENCHMARK(BM_InterpolateVertices)->RangeMultiplier(16)->Range(16, 1 << 20);
@@ -0,0 +1,73 @@
+// Scaling of the job system on a 100k-object animation step (angles, batched transforms and
+// pulsing colors, as in the instanced scene) from one thread up to every core. Wall-clock time,
+// reported per object.
+
+#include <benchmark/benchmark.h>
+
+#include <glcore/JobSystem.h>
+#include <glcore/Mat4.h>
+#include <glcore/TransformBatch.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const int objectCount = 100000;
+
+static void BM_ParallelAnimate(benchmark::State& state) {
+    JobSystem jobs((int)state.range(0));
+    int grain = (int)state.range(1);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    TransformBatch batch;
+    batch.resize(objectCount);
+    std::vector<float> spin(objectCount), phase(objectCount), phases(objectCount), sines(objectCount), cosines(objectCount);
+    for (int i = 0; i < objectCount; ++i) {
+        batch.x[i] = unit(rng) * 2.0f - 1.0f;
+        batch.y[i] = unit(rng) * 2.0f - 1.0f;
+        batch.scale[i] = 0.01f;
+        spin[i] = unit(rng) * 100.0f - 50.0f;
+        phase[i] = unit(rng) * 6.28318f;
+    }
+    std::vector<Mat4> transforms(objectCount);
+    std::vector<float> colors(objectCount * 4);
+
+    float time = 0.0f;
+    for (auto _ : state) {
+        time += 1.0f / 60.0f;
+        jobs.parallelFor(0, objectCount, grain, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                batch.angle[i] = time * spin[i];
+                phases[i] = time * 2.0f + phase[i];
+            }
+            computeTransforms(batch, transforms.data(), begin, end);
+            sinCos(&phases[begin], &sines[begin], &cosines[begin], end - begin);
+            for (int i = begin; i < end; ++i) {
+                float pulse = (sines[i] + 1.0f) / 2.0f;
+                colors[i * 4 + 0] = pulse;
+                colors[i * 4 + 1] = 0.3f;
+                colors[i * 4 + 2] = 0.5f;
+                colors[i * 4 + 3] = 1.0f;
+            }
+        });
+        benchmark::DoNotOptimize(transforms.data());
+        benchmark::DoNotOptimize(colors.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * objectCount);
+    state.counters["steals"] = (double)jobs.getSteals() / state.iterations();
+}
+
+// Thread counts 1, 2, 4, ... up to the hardware thread count, at the scene's grain and a finer one
+static void threadCounts(benchmark::internal::Benchmark* bench) {
+    int hardware = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int grain : { 512, 2048 }) {
+        for (int threads = 1; threads < hardware; threads *= 2) {
+            bench->Args({ threads, grain });
+        }
+        bench->Args({ hardware, grain });
+    }
+}
+BENCHMARK(BM_ParallelAnimate)->Apply(threadCounts)->ArgNames({ "threads", "grain" })->UseRealTime()->Unit(benchmark::kMicrosecond);
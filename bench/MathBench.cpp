@@ -0,0 +1,135 @@
+// Per-matrix cost of the original float[16] helpers (Transform.h) against Mat4.
+// Each iteration processes a batch so the loop overhead and the timer do not dominate.
+
+#include <benchmark/benchmark.h>
+
+#include <glcore/Mat4.h>
+#include <glcore/Transform.h>
+
+#include <random>
+#include <vector>
+
+static const int batchSize = 1024;
+
+static std::vector<Mat4> randomMatrices(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<Mat4> matrices(batchSize);
+    for (Mat4& matrix : matrices) {
+        for (float& value : matrix.m) {
+            value = dist(rng);
+        }
+        // Keep them well conditioned for the inverse benchmark
+        matrix.m[0] += 4.0f; matrix.m[5] += 4.0f; matrix.m[10] += 4.0f; matrix.m[15] += 4.0f;
+    }
+    return matrices;
+}
+
+static std::vector<float> randomAngles(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-360.0f, 360.0f);
+    std::vector<float> angles(batchSize);
+    for (float& angle : angles) {
+        angle = dist(rng);
+    }
+    return angles;
+}
+
+static void BM_LegacyMultiply(benchmark::State& state) {
+    std::vector<Mat4> a = randomMatrices(1), b = randomMatrices(2), out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            multiplyMatrices(a[i].m, b[i].m, out[i].m);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_LegacyMultiply);
+
+static void BM_Mat4Multiply(benchmark::State& state) {
+    std::vector<Mat4> a = randomMatrices(1), b = randomMatrices(2), out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            out[i] = a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Mat4Multiply);
+
+static void BM_LegacyRotation(benchmark::State& state) {
+    std::vector<float> angles = randomAngles(3);
+    std::vector<Mat4> out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            createRotationMatrix(out[i].m, angles[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_LegacyRotation);
+
+// The per-shape transform path of ShapeTransformations before Mat4
+static void BM_LegacyTranslateRotate(benchmark::State& state) {
+    std::vector<float> angles = randomAngles(3);
+    std::vector<Mat4> out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            float rotationMatrix[16];
+            float translationMatrix[16];
+            createRotationMatrix(rotationMatrix, angles[i]);
+            createTranslationMatrix(translationMatrix, -0.5f, 0.0f, 0.0f);
+            multiplyMatrices(translationMatrix, rotationMatrix, out[i].m);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_LegacyTranslateRotate);
+
+static void BM_Mat4TranslateRotate(benchmark::State& state) {
+    std::vector<float> angles = randomAngles(3);
+    std::vector<Mat4> out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            out[i] = translateRotateZ(-0.5f, 0.0f, 0.0f, angles[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Mat4TranslateRotate);
+
+static void BM_Mat4Transpose(benchmark::State& state) {
+    std::vector<Mat4> a = randomMatrices(4), out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            out[i] = transpose(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Mat4Transpose);
+
+static void BM_Mat4Inverse(benchmark::State& state) {
+    std::vector<Mat4> a = randomMatrices(5), out(batchSize);
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; ++i) {
+            out[i] = inverse(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Mat4Inverse);
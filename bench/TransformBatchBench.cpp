@@ -0,0 +1,55 @@
+// Transforming a whole population per frame: one matrix at a time through Mat4 against the
+// structure-of-arrays batch kernel. Reported per object.
+
+#include <benchmark/benchmark.h>
+
+#include <glcore/Mat4.h>
+#include <glcore/TransformBatch.h>
+
+#include <random>
+#include <vector>
+
+static TransformBatch randomBatch(int count) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(-360.0f, 360.0f);
+    std::uniform_real_distribution<float> scale(0.01f, 0.1f);
+
+    TransformBatch batch;
+    batch.resize(count);
+    for (int i = 0; i < count; ++i) {
+        batch.x[i] = position(rng);
+        batch.y[i] = position(rng);
+        batch.angle[i] = angle(rng);
+        batch.scale[i] = scale(rng);
+    }
+    return batch;
+}
+
+static void BM_PerObjectCompose(benchmark::State& state) {
+    int count = (int)state.range(0);
+    TransformBatch batch = randomBatch(count);
+    std::vector<Mat4> out(count);
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = compose(batch.x[i], batch.y[i], 0.0f, batch.angle[i], batch.scale[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PerObjectCompose)->Arg(1000)->Arg(100000);
+
+static void BM_BatchComputeTransforms(benchmark::State& state) {
+    int count = (int)state.range(0);
+    TransformBatch batch = randomBatch(count);
+    std::vector<Mat4> out(count);
+    for (auto _ : state) {
+        computeTransforms(batch, out.data(), 0, count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BatchComputeTransforms)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,104 @@
+// Per-frame buffer upload strategies under the headless context: glBufferSubData into one buffer,
+// orphaning (StreamBuffer without persistent mapping) and a persistently mapped ring. Every frame
+// the GPU copies the uploaded bytes into a sink buffer, so uploads have to respect data the GPU
+// may still be reading, as vertex and instance data would. Wall-clock time per frame.
+
+#include <benchmark/benchmark.h>
+
+#include <glcore/Context.h>
+#include <glcore/StreamBuffer.h>
+
+#include <vector>
+
+// One context for all upload benchmarks, created on first use; nullptr if there is no EGL
+static Context* benchContext() {
+    static Context context;
+    static bool created = false;
+    static bool attempted = false;
+    if (!attempted) {
+        attempted = true;
+        AppOptions options;
+        options.headless = true;
+        options.width = 64;
+        options.height = 64;
+        created = context.create(options, "bench");
+    }
+    return created ? &context : nullptr;
+}
+
+// Makes the GPU read size bytes at offset of buffer, standing in for a draw call
+static void consume(GLuint buffer, GLintptr offset, GLsizeiptr size, GLuint sink) {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, sink);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, size);
+    glFlush();
+}
+
+static GLuint createBuffer(GLsizeiptr size, GLenum usage) {
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, usage);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return buffer;
+}
+
+static void BM_UploadBufferSubData(benchmark::State& state) {
+    if (!benchContext()) {
+        state.SkipWithError("no headless context");
+        return;
+    }
+    GLsizeiptr size = (GLsizeiptr)state.range(0);
+    std::vector<char> data(size, 1);
+    GLuint buffer = createBuffer(size, GL_DYNAMIC_DRAW);
+    GLuint sink = createBuffer(size, GL_STATIC_COPY);
+    for (auto _ : state) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, data.data());
+        consume(buffer, 0, size, sink);
+    }
+    glFinish();
+    glDeleteBuffers(1, &buffer);
+    glDeleteBuffers(1, &sink);
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_UploadBufferSubData)->RangeMultiplier(8)->Range(64 << 10, 4 << 20)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void streamUpload(benchmark::State& state, bool persistent) {
+    if (!benchContext()) {
+        state.SkipWithError("no headless context");
+        return;
+    }
+    GLsizeiptr size = (GLsizeiptr)state.range(0);
+    std::vector<char> data(size, 1);
+    StreamBuffer stream;
+    if (!stream.create(size, 3, persistent)) {
+        state.SkipWithError("stream buffer creation failed");
+        return;
+    }
+    if (persistent && !stream.isPersistent()) {
+        state.SkipWithError("persistent mapping is not supported");
+        return;
+    }
+    GLuint sink = createBuffer(size, GL_STATIC_COPY);
+    for (auto _ : state) {
+        stream.beginFrame();
+        GLintptr offset = stream.upload(data.data(), size);
+        stream.flush();
+        consume(stream.getBuffer(), offset, size, sink);
+    }
+    glFinish();
+    glDeleteBuffers(1, &sink);
+    state.SetBytesProcessed(state.iterations() * size);
+    state.counters["waits"] = (double)stream.getStats().totalWaits;
+}
+
+static void BM_UploadOrphan(benchmark::State& state) {
+    streamUpload(state, false);
+}
+BENCHMARK(BM_UploadOrphan)->RangeMultiplier(8)->Range(64 << 10, 4 << 20)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_UploadPersistent(benchmark::State& state) {
+    streamUpload(state, true);
+}
+BENCHMARK(BM_UploadPersistent)->RangeMultiplier(8)->Range(64 << 10, 4 << 20)->UseRealTime()->Unit(benchmark::kMicrosecond);
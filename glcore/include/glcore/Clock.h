@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+// Where animation time comes from
+enum ClockMode {
+    realtimeClock = 0, // wall-clock seconds since start
+    fixedClock = 1,    // exactly 1 / rate seconds per frame, paced to real time
+    fastClock = 2      // exactly 1 / rate seconds per frame, as fast as the GPU goes (no vsync)
+};
+
+// Animation clock of a Context. The virtual modes derive time from the frame number alone, so a
+// run of N frames produces the same frames every time; fastClock also drops every wait, which
+// makes the frame rate a pure throughput measurement.
+class Clock {
+public:
+    void start(ClockMode mode, double rate);
+
+    // Animation time of the current frame in seconds
+    double getTime() const;
+
+    // Animation time of frame number `frame`; wall time in realtime mode
+    double getFrameTime(long long frame) const;
+
+    // Ends the current frame; in fixedClock mode sleeps until its time has come
+    void endFrame();
+
+    // Wall-clock seconds since start(), whatever the mode
+    double getElapsed() const;
+
+    ClockMode getMode() const { return mode; }
+    bool isVirtual() const { return mode != realtimeClock; }
+    double getStep() const { return step; }
+
+private:
+    ClockMode mode = realtimeClock;
+    double step = 1.0 / 60.0;
+    std::atomic<long long> frame{ 0 }; // advanced on the rendering thread, read on the main thread
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Parses "realtime", "fixed" or "fast"
+bool parseClockMode(const char* text, ClockMode& mode);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glcore/Clock.h>
+#include <glcore/FrameDump.h>
+#include <glcore/FrameStats.h>
+#include <glcore/Options.h>
+#include <glcore/RenderTarget.h>
+
+#include <atomic>
+
+struct GLFWwindow;
+
+// OpenGL 3.3 core context, either in a GLFW window or headless on a surfaceless
+// EGL display (EGL pbuffer, works on llvmpipe with no display and no GPU).
+class Context {
+public:
+    Context() = default;
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+    ~Context();
+
+    // Creates the context, makes it current and loads the GL functions through glad.
+    // Prints the reason and returns false on failure.
+    bool create(const AppOptions& options, const char* title);
+    void destroy();
+
+    // True once the window was closed, Escape was pressed or the frame limit was reached
+    bool shouldClose();
+    void pollEvents();
+    // Presents the frame; with --dump the offscreen frame is read back (every dumpEvery frames)
+    // and copied to the window first. With --stats-interval the frame's times are recorded: CPU
+    // time from the previous present to this call, the present interval between the two.
+    void swapBuffers();
+
+    // Hand the context to another thread: release it on the thread that has it current, then
+    // make it current on the other one. Events (pollEvents, shouldClose) stay on the main thread;
+    // swapBuffers goes with the context.
+    void makeCurrent();
+    void releaseCurrent();
+
+    // Animation time of the current frame in seconds, from the clock picked with --clock
+    double getTime() const { return clock.getTime(); }
+    const Clock& getClock() const { return clock; }
+
+    bool isHeadless() const { return headless; }
+
+    // Size of the framebuffer drawn to: the offscreen target while dumping, the window otherwise
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getFrameCount() const { return frameCount; }
+
+private:
+    bool createWindow(const char* title);
+    bool createHeadless();
+    bool createDump(const AppOptions& options);
+
+    bool headless = false;
+    int width = 0;
+    int height = 0;
+    int surfaceWidth = 0;  // window or pbuffer size
+    int surfaceHeight = 0;
+    int maxFrames = 0;
+    std::atomic<int> frameCount{ 0 }; // counted by the rendering thread, read by the main thread
+    Clock clock;
+
+    RenderTarget offscreen;
+    FrameDumper dumper;
+    int dumpEvery = 1;
+    const char* tracePath = nullptr;
+
+    FrameStats stats;
+    double lastPresent = 0.0; // wall time after the previous swap, seconds
+    long long gpuFramesSeen = 0;
+    bool gpuReport = false;   // print the GPU profile on exit (not when only the stats use it)
+
+    GLFWwindow* window = nullptr;
+    void* eglDisplay = nullptr;
+    void* eglSurface = nullptr;
+    void* eglContext = nullptr;
+};
+
+// GL entry point lookup for the current backend, valid once a Context has been created.
+void* getGLProcAddress(const char* name);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Scoped CPU timing markers for every thread, exported as a Chrome trace (load the JSON in
+// chrome://tracing or ui.perfetto.dev). Each thread records into its own ring of the last
+// ringCapacity scopes, so recording takes no lock: a scope is two clock reads and one store.
+// Threads register their ring once, on their first scope. When disabled a scope costs one branch.
+class CpuProfiler {
+public:
+    CpuProfiler() = default;
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+    // Starts recording, keeping the last ringCapacity scopes of each thread
+    void enable(int ringCapacity = 1 << 16);
+    // Acquire pairs with the release store in enable(): a thread that sees the profiler enabled
+    // also sees its capacity and start time
+    bool isEnabled() const { return enabled.load(std::memory_order_acquire); }
+
+    // Names the calling thread in the trace; name must outlive the profiler (a string literal)
+    static void setThreadName(const char* name);
+
+    // Nanoseconds since enable()
+    int64_t now() const;
+
+    // Appends a finished scope to the calling thread's ring; name must be a string literal
+    void record(const char* name, int64_t begin, int64_t end);
+
+    // Writes every recorded scope as Chrome trace JSON. Call once the recording threads are idle.
+    // Prints the reason and returns false on failure.
+    bool writeTrace(const char* path) const;
+
+private:
+    struct Event {
+        const char* name;
+        int64_t begin;
+        int64_t end;
+    };
+    struct ThreadRing {
+        std::vector<Event> events;
+        std::atomic<uint64_t> written{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        int id = 0;
+    };
+
+    ThreadRing& getRing();
+
+    std::atomic<bool> enabled{ false };
+    int capacity = 0;
+    std::chrono::steady_clock::time_point startTime;
+    mutable std::mutex ringsMutex; // guards the list of rings, not their contents
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+};
+
+// Profiler of the process, enabled by Context::create with --trace
+CpuProfiler& getCpuProfiler();
+
+// Records the enclosing block as a named scope of getCpuProfiler()
+class CpuScope {
+public:
+    explicit CpuScope(const char* name) : name(getCpuProfiler().isEnabled() ? name : nullptr) {
+        if (this->name) {
+            begin = getCpuProfiler().now();
+        }
+    }
+    ~CpuScope() {
+        if (name) {
+            getCpuProfiler().record(name, begin, getCpuProfiler().now());
+        }
+    }
+    CpuScope(const CpuScope&) = delete;
+    CpuScope& operator=(const CpuScope&) = delete;
+
+private:
+    const char* name;
+    int64_t begin = 0;
+};
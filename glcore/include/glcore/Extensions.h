@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// GL 4.x entry points beyond the vendored GL 3.3 glad loader. Each feature is available when the
+// context version or the matching ARB extension provides it; callers check the flag and fall
+// back to the GL 3.3 path otherwise.
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+typedef void (APIENTRYP PFNGLMULTIDRAWARRAYSINDIRECTPROC)(GLenum mode, const void* indirect, GLsizei drawCount, GLsizei stride);
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#endif
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+// Layout of one glMultiDrawArraysIndirect command
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance;
+};
+
+struct GLExtensions {
+    bool bufferStorage = false; // GL 4.4 or ARB_buffer_storage
+    PFNGLBUFFERSTORAGEPROC bufferStorageProc = nullptr;
+
+    // GL 4.3 or ARB_multi_draw_indirect together with ARB_base_instance, so the commands can
+    // select per-draw data through their baseInstance
+    bool multiDrawIndirect = false;
+    PFNGLMULTIDRAWARRAYSINDIRECTPROC multiDrawArraysIndirectProc = nullptr;
+};
+
+// Queries the current context, called by Context::create once glad is loaded
+void loadExtensions();
+
+const GLExtensions& getExtensions();
+
+// True if the current context lists the named extension
+bool hasExtension(const char* name);
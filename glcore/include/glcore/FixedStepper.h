@@ -0,0 +1,42 @@
+#pragma once
+
+// Fixed-timestep clock for an update/render split. Each frame, advance() takes the current
+// time and returns how many simulation ticks of getStep() seconds to run; the time left over
+// stays in an accumulator for the next frame. Rendering then blends the last two simulated
+// states with getAlpha(), so motion stays smooth at any frame rate while the simulation always
+// runs at the same rate.
+class FixedStepper {
+public:
+    // maxTicksPerFrame bounds the catch-up after a stall, dropping the excess time instead of
+    // letting a slow simulation fall further and further behind
+    explicit FixedStepper(double step = 1.0 / 60.0, int maxTicksPerFrame = 8);
+
+    // Starts counting from now, with no ticks pending
+    void reset(double now);
+
+    // Adds the time since the previous call and returns the number of ticks to simulate
+    int advance(double now);
+
+    // Blend factor in [0, 1) from the previous tick's state to the current one
+    float getAlpha() const { return (float)(accumulator / step); }
+
+    double getStep() const { return step; }
+
+    // Simulation time of the current state, after getTicks() ticks
+    double getTime() const { return ticks * step; }
+
+    // Simulation time the rendered (blended) state corresponds to
+    double getRenderTime() const { return (ticks - 1) * step + accumulator; }
+
+    long long getTicks() const { return ticks; }
+    long long getDroppedTicks() const { return droppedTicks; }
+
+private:
+    double step;
+    int maxTicksPerFrame;
+    double accumulator = 0.0;
+    double lastTime = 0.0;
+    bool started = false;
+    long long ticks = 0;
+    long long droppedTicks = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// True if pattern holds exactly one int conversion (%d, %04d, %x, ...) and otherwise only %%,
+// so it can be handed to snprintf with the frame number
+bool isFramePattern(const char* pattern);
+
+// Writes rendered frames to image files without stalling the GL pipeline. capture() starts an
+// asynchronous glReadPixels into one of two pixel buffer objects and collects the frame read by
+// the previous capture from the other one, which the GPU has finished by then. The pixels go to a
+// writer thread that flips and encodes them as PPM, or PNG when built with libpng.
+class FrameDumper {
+public:
+    FrameDumper() = default;
+    FrameDumper(const FrameDumper&) = delete;
+    FrameDumper& operator=(const FrameDumper&) = delete;
+    ~FrameDumper();
+
+    // pathPattern is a printf pattern taking the frame number, e.g. "out/frame_%04d.png"; a .png
+    // extension selects PNG, anything else PPM (see isFramePattern). Prints the reason and returns
+    // false on failure.
+    bool create(const char* pathPattern, int width, int height);
+
+    // Reads the current read framebuffer as frame number `frame`
+    void capture(int frame);
+
+    // Collects the last capture, waits until every file is written and releases the buffers
+    void finish();
+
+    bool isActive() const { return pixelBuffers[0] != 0; }
+    int getWritten() const { return written; }
+    int getFailed() const { return failed; }
+
+    // Captures that had to wait for the writer thread to catch up
+    int getStalls() const { return stalls; }
+
+private:
+    struct Image {
+        std::string path;
+        std::vector<unsigned char> pixels; // RGBA, bottom row first as read from GL
+    };
+
+    void collect(int slot);
+    void writerLoop();
+    bool writeImage(const Image& image);
+
+    std::string pattern;
+    bool png = false;
+    int width = 0;
+    int height = 0;
+    GLuint pixelBuffers[2] = {};
+    int pendingFrame[2] = { -1, -1 };
+    int nextSlot = 0;
+    int stalls = 0;
+
+    std::thread writer;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    std::deque<Image> queue;
+    bool stopping = false;
+    int written = 0; // writer thread only until finish() joins it
+    int failed = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glcore/Histogram.h>
+
+#include <cstdio>
+
+// Frame-time readout for the demos: CPU time, GPU time and present interval of every frame go
+// into HDR histograms, and every interval seconds their p50/p95/p99/max, the frames that missed
+// their deadline and the frame rate are printed and, with a CSV path, appended as one row.
+// A frame misses its deadline when its present interval exceeds 1.5 frame budgets, i.e. it took
+// at least one whole extra refresh.
+class FrameStats {
+public:
+    FrameStats() = default;
+    FrameStats(const FrameStats&) = delete;
+    FrameStats& operator=(const FrameStats&) = delete;
+    ~FrameStats();
+
+    // now is the wall time in seconds the frames are measured from; budgetMilliseconds is the
+    // target frame time. Prints the reason and returns false when the CSV file cannot be opened.
+    bool start(double intervalSeconds, double budgetMilliseconds, const char* csvPath, double now);
+    // Reports the frames since the last interval and closes the CSV file
+    void finish(double now);
+    bool isEnabled() const { return intervalSeconds > 0.0; }
+
+    void recordFrame(double cpuMilliseconds, double presentMilliseconds);
+    // GPU times arrive a few frames late (see GpuProfiler), so they are recorded separately
+    void recordGpu(double milliseconds);
+    // Reports and starts a new interval once intervalSeconds have passed
+    void update(double now);
+
+private:
+    void report(double now);
+    void reset(double now);
+
+    double intervalSeconds = 0.0;
+    double budgetMilliseconds = 0.0;
+    double intervalStart = 0.0;
+    double startTime = 0.0;
+    FILE* csv = nullptr;
+    // Microseconds, up to a minute
+    HdrHistogram cpu;
+    HdrHistogram gpu;
+    HdrHistogram present;
+    long long missed = 0;
+    long long totalFrames = 0;
+    long long totalMissed = 0;
+};
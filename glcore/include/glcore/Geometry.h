@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+
+// Function to generate vertices for a circle outline (x, y, z per vertex, z = 0)
+std::vector<GLfloat> generateCircleVertices(float centerX, float centerY, float radius, int segments);
+
+// Smallest and largest segment counts chosen by adaptiveCircleSegments
+const int minAdaptiveSegments = 8;
+const int maxAdaptiveSegments = 256;
+
+// Segment count for a circle covering radiusPixels on screen whose chords stay within
+// maxErrorPixels of the true outline, rounded up to a power-of-two LOD bucket so nearby sizes
+// share one cached mesh
+int adaptiveCircleSegments(float radiusPixels, float maxErrorPixels = 0.5f);
+
+// Adaptive mode of generateCircleVertices: the segment count follows the projected radius
+std::vector<GLfloat> generateCircleVertices(float centerX, float centerY, float radius, float radiusPixels, float maxErrorPixels);
+
+// Interpolates between two values (lerp function)
+float lerp(float start, float end, float t);
+
+// Interpolates between two angles in degrees along the shorter way around
+float lerpAngle(float start, float end, float t);
+
+// Interpolates between two sets of xyz vertices, both holding at least vertexCount vertices
+void interpolateVertices(const GLfloat* startVertices, const GLfloat* endVertices, GLfloat* result, float t, int vertexCount);
+
+// Resamples a closed outline of vertexCount xyz vertices to sampleCount points, counter-clockwise,
+// starting at the first vertex. Samples are spread over the edges in proportion to their length
+// and every original corner is kept, so sampleCount must be at least vertexCount (it is raised
+// to vertexCount otherwise).
+std::vector<GLfloat> resampleOutline(const GLfloat* vertices, int vertexCount, int sampleCount);
+
+// Morph targets for two closed outlines with any vertex counts (triangle, square, circle, polygon).
+// Both are resampled to the same count and the target is rotated to the start that best matches
+// the source. The result is interleaved per vertex as (source xyz, target xyz) and laid out as a
+// triangle fan: the two centroids, the samples, then the first sample again to close it, so one
+// glDrawArrays(GL_TRIANGLE_FAN, 0, morphVertexCount(sampleCount)) draws any blend of the pair.
+// The fan is only correct for outlines that are star-shaped around their area centroid (every
+// sample visible from it), which covers all convex shapes; other concave outlines get overlapping
+// or inverted triangles.
+std::vector<GLfloat> buildMorphTargets(const GLfloat* fromVertices, int fromCount, const GLfloat* toVertices, int toCount, int sampleCount);
+
+// Number of fan vertices in buildMorphTargets output
+int morphVertexCount(int sampleCount);
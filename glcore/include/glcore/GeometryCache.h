@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glcore/MeshArena.h>
+#include <glad/glad.h>
+
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
+// Kinds of generated meshes; demos may add their own above customShape
+enum ShapeKind {
+    circleShape = 0,
+    customShape = 100
+};
+
+// Parameters a generated mesh is memoized by
+struct GeometryKey {
+    int shape;
+    float radius;
+    int segments;
+
+    bool operator<(const GeometryKey& other) const {
+        return std::tie(shape, radius, segments) < std::tie(other.shape, other.radius, other.segments);
+    }
+};
+
+// Memoizes generated meshes by their parameters. Each distinct key is generated and appended to
+// the shared MeshArena once; later requests get the same MeshRange back. flush() uploads the
+// arena only when something new was added, so spawning thousands of shapes from a few keys
+// costs a few generations and one upload.
+class GeometryCache {
+public:
+    explicit GeometryCache(MeshArena& arena) : arena(arena) {}
+
+    // Circle outline of generateCircleVertices around the origin
+    MeshRange getCircle(float radius, int segments);
+
+    // Circle whose segment count follows its projected size (see adaptiveCircleSegments); every
+    // size in one LOD bucket shares a mesh
+    MeshRange getAdaptiveCircle(float radius, float radiusPixels, float maxErrorPixels = 0.5f);
+
+    // Mesh for key, built with generate (xyz positions) the first time the key is seen
+    MeshRange get(const GeometryKey& key, const std::function<std::vector<GLfloat>()>& generate);
+
+    // Uploads the arena if meshes were added since the last flush
+    void flush();
+
+    int getHits() const { return hits; }
+    int getMisses() const { return misses; }
+    int getUploads() const { return uploads; }
+    double getHitRate() const { return hits + misses > 0 ? (double)hits / (hits + misses) : 0.0; }
+
+private:
+    MeshArena& arena;
+    std::map<GeometryKey, MeshRange> meshes;
+    bool dirty = false;
+    int hits = 0;
+    int misses = 0;
+    int uploads = 0;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+
+// GPU time per named scope, measured with GL_TIMESTAMP queries. Queries are recorded into a pool
+// of frameLatency frames and only read once the GPU has moved on, so profiling never waits for
+// the GPU: a frame whose queries are still pending when its slot comes round again is skipped
+// and counted as late. Scopes may nest; a scope entered several times in a frame adds up.
+// Per-scope min, average and 99th percentile are kept over the last windowFrames frames.
+//
+// Not thread-safe: record scopes on the thread that owns the GL context.
+class GpuProfiler {
+public:
+    GpuProfiler() = default;
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Starts recording; scopes are ignored until then
+    void enable(int frameLatency = 4, int windowFrames = 240);
+    void disable();
+    bool isEnabled() const { return enabled; }
+
+    // name must stay valid for the profiler's lifetime (a string literal)
+    void beginScope(const char* name);
+    void endScope();
+
+    // Ends the frame (called by Context::swapBuffers) and collects the oldest frame that finished
+    void nextFrame();
+
+    // Frames collected since enable() and the whole-frame GPU time of the newest one
+    long long getCollectedFrames() const { return collectedFrames; }
+    float getLastFrameMilliseconds() const { return lastFrameMilliseconds; }
+
+    // Prints min/avg/p99 milliseconds per scope, plus the whole frame
+    void report() const;
+
+private:
+    struct Marker {
+        int scope;
+        GLuint begin;
+        GLuint end;
+    };
+    struct FrameSlot {
+        std::vector<GLuint> queries; // pooled, reused every time the slot comes round
+        std::vector<Marker> markers;
+        int usedQueries = 0;
+    };
+    struct ScopeStats {
+        const char* name;
+        std::vector<float> samples; // ring of the last windowFrames frames, milliseconds
+        int next = 0;
+    };
+
+    int findScope(const char* name);
+    GLuint takeQuery();
+    void collect(FrameSlot& slot);
+    void addSample(int scope, float milliseconds);
+
+    bool enabled = false;
+    int windowFrames = 0;
+    int current = 0;
+    std::vector<FrameSlot> slots;
+    std::vector<int> openMarkers; // markers of the current slot whose end is not recorded yet
+    std::vector<ScopeStats> scopes; // scope 0 is the whole frame
+    long long collectedFrames = 0;
+    long long lateFrames = 0;
+    float lastFrameMilliseconds = 0.0f;
+};
+
+// Profiler of the current context, enabled by Context::create with --gpu-profile or --stats-interval
+GpuProfiler& getGpuProfiler();
+
+// Records the enclosing block as a named GPU scope of getGpuProfiler()
+class GpuScope {
+public:
+    explicit GpuScope(const char* name) { getGpuProfiler().beginScope(name); }
+    ~GpuScope() { getGpuProfiler().endScope(); }
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+};
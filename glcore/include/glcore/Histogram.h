@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// High-dynamic-range histogram of non-negative integers (HdrHistogram layout): every power-of-two
+// range is split into the same number of linear sub-buckets, so any value from 1 to highestValue
+// is kept to within 1% (two significant digits) in a fixed, small array. Recording is one index
+// computation and an increment; percentiles walk the buckets.
+class HdrHistogram {
+public:
+    explicit HdrHistogram(int64_t highestValue = 60000000);
+
+    // Values above highestValue count as highestValue, negative ones as 0
+    void record(int64_t value);
+    void reset();
+
+    int64_t getCount() const { return count; }
+    int64_t getMax() const { return count > 0 ? maxValue : 0; }
+    double getMean() const { return count > 0 ? (double)sum / count : 0.0; }
+
+    // Smallest recorded value v (to bucket precision) with at least percent% of the values <= v
+    int64_t getPercentile(double percent) const;
+
+private:
+    int countsIndex(int64_t value) const;
+    int64_t highestEquivalentValue(int index) const;
+
+    int64_t highestValue;
+    std::vector<int64_t> counts;
+    int64_t count = 0;
+    int64_t sum = 0;
+    int64_t maxValue = 0;
+};
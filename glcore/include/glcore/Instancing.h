@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Attribute locations of instancedVertexShaderSource
+const GLuint instanceTransformLocation = 1; // a mat4 takes four locations, 1 to 4
+const GLuint instanceColorLocation = 5;
+
+// Per-instance circle shape of circleVertexShaderSource: radius and outline thickness
+const GLuint instanceCircleLocation = 6;
+
+// Vertices of one circle quad, drawn as GL_TRIANGLE_STRIP from gl_VertexID with no vertex buffer
+const GLsizei circleQuadVertexCount = 4;
+
+// Points the instance transform attribute of the bound VAO at tightly packed Mat4s in buffer,
+// starting at offset bytes, advancing once per instance
+void bindInstanceTransforms(GLuint buffer, GLintptr offset);
+
+// Same for tightly packed RGBA float colors
+void bindInstanceColors(GLuint buffer, GLintptr offset);
+
+// Same for tightly packed (radius, thickness) pairs; thickness 0 draws a filled disc
+void bindInstanceCircles(GLuint buffer, GLintptr offset);
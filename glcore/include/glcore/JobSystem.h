@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing scheduler for data-parallel loops over many objects. Every thread owns a deque of
+// ranges: it splits its range in halves down to the grain size, keeps working on the front half
+// and pushes the back half onto its own deque, where idle threads steal it from the other end.
+// Big ranges therefore spread over all threads after a few splits, and a thread that finishes
+// early takes over work from a busy one instead of waiting.
+class JobSystem {
+public:
+    // Body of a parallel loop, called for disjoint subranges [begin, end)
+    using RangeFunction = std::function<void(int begin, int end)>;
+
+    // threadCount includes the calling thread; 0 uses every hardware thread
+    explicit JobSystem(int threadCount = 0);
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem();
+
+    // Runs body over [begin, end) in subranges of at most grain items and returns once all of
+    // them are done. The calling thread works too. Calls from inside a body run serially; only
+    // one thread outside the pool may call parallelFor at a time.
+    void parallelFor(int begin, int end, int grain, const RangeFunction& body);
+
+    int getThreadCount() const { return (int)queues.size(); }
+
+    // Ranges taken from another thread's deque since construction
+    long long getSteals() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        const RangeFunction* body;
+        int begin;
+        int end;
+        int grain;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void push(int queue, const Job& job);
+    bool pop(int queue, Job& job);
+    bool steal(int thief, Job& job);
+    void run(int queue, Job job);
+    void workerLoop(int queue);
+
+    std::vector<std::unique_ptr<Queue>> queues; // queue 0 belongs to the thread calling parallelFor
+    std::vector<std::thread> workers;
+    std::atomic<int> queuedJobs{ 0 };
+    std::atomic<int> remainingItems{ 0 };
+    std::atomic<long long> steals{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
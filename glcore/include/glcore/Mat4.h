@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cmath>
+
+// SIMD backend, picked at compile time from the target flags. Define GLCORE_MAT4_SCALAR to
+// force the portable path (configure with GLCORE_NATIVE_ARCH=ON to get the AVX one on x86).
+#if !defined(GLCORE_MAT4_SCALAR)
+#if defined(__AVX__)
+#define GLCORE_MAT4_AVX
+#define GLCORE_MAT4_SSE
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLCORE_MAT4_SSE
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GLCORE_MAT4_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+struct alignas(16) Vec4 {
+    float x, y, z, w;
+};
+
+// 4x4 matrix with the same element order as the float[16] helpers in Transform.h:
+// written row by row, uploaded with glUniformMatrix4fv(..., GL_FALSE, data()).
+struct alignas(16) Mat4 {
+    float m[16];
+
+    const float* data() const { return m; }
+    float* data() { return m; }
+
+    static Mat4 identity();
+};
+
+// Degrees to radians with the same pi constant as createRotationMatrix
+inline float degreesToRadians(float degrees) {
+    return degrees * 3.14159f / 180.0f;
+}
+
+Mat4 multiply(const Mat4& a, const Mat4& b);
+Vec4 multiply(const Mat4& a, const Vec4& v);
+Mat4 transpose(const Mat4& a);
+// General inverse, the matrix must be invertible
+Mat4 inverse(const Mat4& a);
+
+inline Mat4 operator*(const Mat4& a, const Mat4& b) { return multiply(a, b); }
+inline Vec4 operator*(const Mat4& a, const Vec4& v) { return multiply(a, v); }
+
+// Builders, equivalent to createRotationMatrix / createTranslationMatrix
+Mat4 rotationZ(float degrees);
+Mat4 translation(float x, float y, float z);
+Mat4 scale(float x, float y, float z);
+
+// Fused translation(x, y, z) * rotationZ(degrees) without the generic multiply
+Mat4 translateRotateZ(float x, float y, float z, float degrees);
+// Fused translation(x, y, z) * rotationZ(degrees) * scale(s, s, 1)
+Mat4 compose(float x, float y, float z, float degrees, float s);
+
+// ---------------------------------------------------------------------------
+
+inline Mat4 Mat4::identity() {
+    return Mat4{ {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+inline Mat4 multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r;
+#if defined(GLCORE_MAT4_AVX)
+    // Two result rows per iteration: each row of a broadcasts its elements over the rows of b
+    __m256 b0 = _mm256_broadcast_ps((const __m128*)&b.m[0]);
+    __m256 b1 = _mm256_broadcast_ps((const __m128*)&b.m[4]);
+    __m256 b2 = _mm256_broadcast_ps((const __m128*)&b.m[8]);
+    __m256 b3 = _mm256_broadcast_ps((const __m128*)&b.m[12]);
+    for (int i = 0; i < 16; i += 8) {
+        __m256 rows = _mm256_loadu_ps(&a.m[i]);
+        __m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+        _mm256_storeu_ps(&r.m[i], sum);
+    }
+#elif defined(GLCORE_MAT4_SSE)
+    __m128 b0 = _mm_load_ps(&b.m[0]);
+    __m128 b1 = _mm_load_ps(&b.m[4]);
+    __m128 b2 = _mm_load_ps(&b.m[8]);
+    __m128 b3 = _mm_load_ps(&b.m[12]);
+    for (int i = 0; i < 16; i += 4) {
+        __m128 row = _mm_load_ps(&a.m[i]);
+        __m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), b0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), b1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), b2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), b3));
+        _mm_store_ps(&r.m[i], sum);
+    }
+#elif defined(GLCORE_MAT4_NEON)
+    float32x4_t b0 = vld1q_f32(&b.m[0]);
+    float32x4_t b1 = vld1q_f32(&b.m[4]);
+    float32x4_t b2 = vld1q_f32(&b.m[8]);
+    float32x4_t b3 = vld1q_f32(&b.m[12]);
+    for (int i = 0; i < 16; i += 4) {
+        float32x4_t row = vld1q_f32(&a.m[i]);
+        float32x4_t sum = vmulq_laneq_f32(b0, row, 0);
+        sum = vfmaq_laneq_f32(sum, b1, row, 1);
+        sum = vfmaq_laneq_f32(sum, b2, row, 2);
+        sum = vfmaq_laneq_f32(sum, b3, row, 3);
+        vst1q_f32(&r.m[i], sum);
+    }
+#else
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r.m[i * 4 + j] = a.m[i * 4 + 0] * b.m[0 * 4 + j] +
+                a.m[i * 4 + 1] * b.m[1 * 4 + j] +
+                a.m[i * 4 + 2] * b.m[2 * 4 + j] +
+                a.m[i * 4 + 3] * b.m[3 * 4 + j];
+        }
+    }
+#endif
+    return r;
+}
+
+inline Vec4 multiply(const Mat4& a, const Vec4& v) {
+    Vec4 r;
+#if defined(GLCORE_MAT4_SSE)
+    // Transposed rows so the products can be summed column-wise without a horizontal add
+    __m128 r0 = _mm_load_ps(&a.m[0]);
+    __m128 r1 = _mm_load_ps(&a.m[4]);
+    __m128 r2 = _mm_load_ps(&a.m[8]);
+    __m128 r3 = _mm_load_ps(&a.m[12]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    __m128 vec = _mm_load_ps(&v.x);
+    __m128 sum = _mm_mul_ps(r0, _mm_shuffle_ps(vec, vec, 0x00));
+    sum = _mm_add_ps(sum, _mm_mul_ps(r1, _mm_shuffle_ps(vec, vec, 0x55)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(r2, _mm_shuffle_ps(vec, vec, 0xAA)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(r3, _mm_shuffle_ps(vec, vec, 0xFF)));
+    _mm_store_ps(&r.x, sum);
+#else
+    r.x = a.m[0] * v.x + a.m[1] * v.y + a.m[2] * v.z + a.m[3] * v.w;
+    r.y = a.m[4] * v.x + a.m[5] * v.y + a.m[6] * v.z + a.m[7] * v.w;
+    r.z = a.m[8] * v.x + a.m[9] * v.y + a.m[10] * v.z + a.m[11] * v.w;
+    r.w = a.m[12] * v.x + a.m[13] * v.y + a.m[14] * v.z + a.m[15] * v.w;
+#endif
+    return r;
+}
+
+inline Mat4 transpose(const Mat4& a) {
+    Mat4 r;
+#if defined(GLCORE_MAT4_SSE)
+    __m128 r0 = _mm_load_ps(&a.m[0]);
+    __m128 r1 = _mm_load_ps(&a.m[4]);
+    __m128 r2 = _mm_load_ps(&a.m[8]);
+    __m128 r3 = _mm_load_ps(&a.m[12]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_store_ps(&r.m[0], r0);
+    _mm_store_ps(&r.m[4], r1);
+    _mm_store_ps(&r.m[8], r2);
+    _mm_store_ps(&r.m[12], r3);
+#elif defined(GLCORE_MAT4_NEON)
+    float32x4x4_t rows = vld4q_f32(a.m); // de-interleaving load is a transpose
+    vst1q_f32(&r.m[0], rows.val[0]);
+    vst1q_f32(&r.m[4], rows.val[1]);
+    vst1q_f32(&r.m[8], rows.val[2]);
+    vst1q_f32(&r.m[12], rows.val[3]);
+#else
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r.m[j * 4 + i] = a.m[i * 4 + j];
+        }
+    }
+#endif
+    return r;
+}
+
+inline Mat4 rotationZ(float degrees) {
+    return translateRotateZ(0.0f, 0.0f, 0.0f, degrees);
+}
+
+inline Mat4 translation(float x, float y, float z) {
+    return Mat4{ {
+        1.0f, 0.0f, 0.0f, x,
+        0.0f, 1.0f, 0.0f, y,
+        0.0f, 0.0f, 1.0f, z,
+        0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+inline Mat4 scale(float x, float y, float z) {
+    return Mat4{ {
+        x, 0.0f, 0.0f, 0.0f,
+        0.0f, y, 0.0f, 0.0f,
+        0.0f, 0.0f, z, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+inline Mat4 translateRotateZ(float x, float y, float z, float degrees) {
+    float rad = degreesToRadians(degrees);
+    float cosA = std::cos(rad);
+    float sinA = std::sin(rad);
+    return Mat4{ {
+        cosA, -sinA, 0.0f, x,
+        sinA, cosA, 0.0f, y,
+        0.0f, 0.0f, 1.0f, z,
+        0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+inline Mat4 compose(float x, float y, float z, float degrees, float s) {
+    float rad = degreesToRadians(degrees);
+    float cosA = std::cos(rad) * s;
+    float sinA = std::sin(rad) * s;
+    return Mat4{ {
+        cosA, -sinA, 0.0f, x,
+        sinA, cosA, 0.0f, y,
+        0.0f, 0.0f, 1.0f, z,
+        0.0f, 0.0f, 0.0f, 1.0f } };
+}
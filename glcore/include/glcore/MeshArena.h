@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+
+// Floats per arena vertex: position xyz followed by morph target xyz
+const int arenaVertexFloats = 6;
+
+// Location of a mesh inside a MeshArena, ready for glDrawArrays
+struct MeshRange {
+    GLint firstVertex = 0;
+    GLsizei vertexCount = 0;
+};
+
+// All static meshes of a scene in one vertex buffer, so they can be drawn without rebinding
+// and batched into indirect draws. Every vertex carries a position and a morph target; meshes
+// without a target repeat the position, so they draw unchanged at any morph weight.
+class MeshArena {
+public:
+    MeshArena() = default;
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+    ~MeshArena();
+
+    // Appends vertexCount xyz positions, with matching morph targets if given
+    MeshRange addMesh(const GLfloat* positions, int vertexCount, const GLfloat* targets = nullptr);
+
+    // Appends interleaved (position xyz, target xyz) vertices, as built by buildMorphTargets
+    MeshRange addMorphMesh(const std::vector<GLfloat>& interleaved);
+
+    // Uploads everything added so far into a static buffer, replacing an earlier upload
+    void upload();
+    void destroy();
+
+    // Points attributes 0 (position) and 1 (target) of the bound VAO at the arena
+    void bindAttributes() const;
+
+    GLuint getBuffer() const { return buffer; }
+    int getVertexCount() const { return (int)(vertices.size() / arenaVertexFloats); }
+
+private:
+    std::vector<GLfloat> vertices;
+    GLuint buffer = 0;
+};
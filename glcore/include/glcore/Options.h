@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glcore/Clock.h>
+
+// Command-line options shared by all demos.
+struct AppOptions {
+    int width = 800;
+    int height = 800;
+    bool headless = false; // render into a surfaceless EGL context instead of a window
+    int frames = 0;        // stop after this many frames, 0 runs until the window is closed
+    ClockMode clock = realtimeClock; // animation time source, see Clock.h
+    int clockRate = 60;    // frames per second of the fixed and fast clocks
+    int threads = 0;       // worker threads for per-object animation including the main one, 0 uses every core
+    int tickRate = 60;     // simulation ticks per second, independent of the frame rate
+    int instances = 0;     // ShapeTransformations: draw this many instanced shapes instead of the original three
+    int circles = 0;       // ShapeTransformations: draw a field of this many tessellated circles instead
+    int procedural = 0;    // ShapeTransformations: draw this many shapes generated in the vertex shader instead
+    bool orphanStreams = false; // stream dynamic data by buffer orphaning even where persistent mapping works
+    bool indirectDraws = true;  // batch draws with multi-draw-indirect where supported
+    const char* dumpPath = nullptr; // printf pattern of frame images to write, e.g. "out/frame_%04d.png"
+    int dumpEvery = 1;     // dump every Nth frame, starting with the first
+    int dumpWidth = 0;     // offscreen resolution while dumping, 0 uses the framebuffer size
+    int dumpHeight = 0;
+    const char* tracePath = nullptr; // write a Chrome trace of the CPU scopes here on exit
+    bool gpuProfile = false;    // time named GPU scopes with timer queries and print them on exit
+    bool renderThread = false;  // ShapeTransformations instanced scene: submit GL from a render thread
+    double statsInterval = 0.0; // print frame-time percentiles every this many seconds, 0 turns them off
+    const char* statsCsv = nullptr; // also append each stats interval to this CSV file
+};
+
+// Parses argv into options. Prints usage and returns false on --help or a bad argument.
+bool parseOptions(int argc, char** argv, AppOptions& options);
+
+void printUsage(const char* program);
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// One shape of proceduralVertexShaderSource: a filled regular polygon (3 sides for a triangle,
+// 4 for a quad, many for a circle) synthesized from gl_VertexID, so it needs no vertex buffer.
+struct ProceduralShape {
+    float centerX;
+    float centerY;
+    float radius;
+    float angle;    // degrees, the first corner points along +x at 0
+    float color[4];
+    float segments; // sides of the polygon, at most the segment count of the draw
+    float spin;     // degrees per second, added to angle using the FrameData time
+    float padding[2];
+};
+
+// Per-instance attribute locations of proceduralVertexShaderSource
+const GLuint proceduralShapeLocation = 0; // center xy, radius, angle
+const GLuint proceduralColorLocation = 1;
+const GLuint proceduralParamsLocation = 2; // segments, spin
+
+// Vertices to draw per instance for shapes of up to segments sides, as GL_TRIANGLES.
+// Triangles beyond an instance's own segment count collapse to its center and draw nothing.
+inline GLsizei proceduralVertexCount(int segments) {
+    return segments * 3;
+}
+
+// Points the procedural attributes of the bound VAO at tightly packed ProceduralShapes in buffer,
+// starting at offset bytes, advancing once per instance
+void bindProceduralShapes(GLuint buffer, GLintptr offset);
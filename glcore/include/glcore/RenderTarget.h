@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Offscreen color target: a framebuffer object with an RGBA8 renderbuffer of any size, rendered
+// to instead of the window or pbuffer so frames can be read back at a fixed resolution.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+    ~RenderTarget();
+
+    // Creates the framebuffer. Prints the reason and returns false on failure.
+    bool create(int width, int height);
+    void destroy();
+
+    // Directs drawing and reading to the target
+    void bind();
+
+    // Copies the target to the default framebuffer (scaled to its size), then binds the target again
+    void blitToDefault(int defaultWidth, int defaultHeight);
+
+    bool isCreated() const { return framebuffer != 0; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    int width = 0;
+    int height = 0;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glcore/MeshArena.h>
+#include <glcore/StreamBuffer.h>
+#include <glad/glad.h>
+
+#include <vector>
+
+// Per-draw data of batchVertexShaderSource, fed as instance attributes (locations 2 to 7)
+struct DrawRecord {
+    float transform[16]; // row-major Mat4, applied like the DrawData transform
+    float color[4];
+    float morph;
+    float padding[3];
+};
+
+// Attribute locations of batchVertexShaderSource beyond the arena's position and target
+const GLuint batchTransformLocation = 2; // a mat4 takes four locations, 2 to 5
+const GLuint batchColorLocation = 6;
+const GLuint batchMorphLocation = 7;
+
+// Collects the draws of a frame over one MeshArena and submits them with one
+// glMultiDrawArraysIndirect per primitive type, so the number of GL draw calls does not grow
+// with the number of shapes. Each command draws one instance whose baseInstance selects its
+// DrawRecord. Records and commands go into a StreamBuffer in one write per frame.
+//
+// Draws are grouped by primitive type in order of the type's first use, keeping their order
+// within a type. Without multi-draw-indirect (or with allowIndirect false) the same commands are
+// replayed one glDrawArrays at a time, pointing the record attributes at each draw.
+class SceneBatcher {
+public:
+    SceneBatcher() = default;
+    SceneBatcher(const SceneBatcher&) = delete;
+    SceneBatcher& operator=(const SceneBatcher&) = delete;
+    ~SceneBatcher();
+
+    // Prints the reason and returns false on failure
+    bool create(const MeshArena& arena, int maxDraws, bool allowPersistent = true, bool allowIndirect = true);
+    void destroy();
+
+    void begin();
+    void add(GLenum mode, const MeshRange& mesh, const DrawRecord& record);
+
+    // Uploads the frame's records and commands and draws them with the bound program. Prints the
+    // reason and returns false, drawing nothing, when they do not fit in the frame's stream region.
+    bool submit();
+
+    bool isIndirect() const { return indirect; }
+    int getDrawCount() const { return (int)draws.size(); }
+    int getSubmissionCount() const { return submissions; } // GL draw calls of the last submit()
+    const StreamStats& getStreamStats() const { return stream.getStats(); }
+
+private:
+    struct PendingDraw {
+        GLenum mode;
+        MeshRange mesh;
+        int record;
+    };
+
+    // Points the record attributes of the VAO at the record stored at offset
+    void bindRecords(GLintptr offset);
+
+    StreamBuffer stream;
+    GLuint vertexArray = 0;
+    int maxDraws = 0;
+    bool indirect = false;
+    int submissions = 0;
+
+    std::vector<DrawRecord> records;
+    std::vector<PendingDraw> draws;
+    std::vector<GLenum> modes; // primitive types in order of first use this frame
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <glcore/UniformBlocks.h>
+#include <glad/glad.h>
+
+// Vertex shader shared by the shape demos: positions transformed by the per-draw matrix of the
+// DrawData block (see UniformBlocks.h)
+inline const char* const transformVertexShaderSource = "#version 330 core\n"
+GLCORE_UNIFORM_BLOCKS_GLSL
+"layout(location = 0) in vec3 aPos;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = viewProjection * (transform * vec4(aPos, 1.0));\n"
+"}\0";
+
+// Fragment shader filling with the per-draw color of the DrawData block
+inline const char* const colorFragmentShaderSource = "#version 330 core\n"
+GLCORE_UNIFORM_BLOCKS_GLSL
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = color;\n"
+"}\n\0";
+
+// Vertex shader for instanced draws: transform and color come from per-instance attributes
+// (see Instancing.h). The row-major Mat4 is applied as written, so its translation moves the shape.
+inline const char* const instancedVertexShaderSource = "#version 330 core\n"
+"layout(location = 0) in vec3 aPos;\n"
+"layout(location = 1) in mat4 aTransform;\n"
+"layout(location = 5) in vec4 aColor;\n"
+"out vec4 vColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos, 1.0) * aTransform;\n"
+"   vColor = aColor;\n"
+"}\0";
+
+// Vertex shader for SceneBatcher draws over a MeshArena: the DrawData values come from the
+// per-draw DrawRecord attributes instead. The transform is applied as in the DrawData shaders,
+// so batched shapes land exactly where their one-draw-per-shape versions did.
+inline const char* const batchVertexShaderSource = "#version 330 core\n"
+GLCORE_UNIFORM_BLOCKS_GLSL
+"layout(location = 0) in vec3 aPos;\n"
+"layout(location = 1) in vec3 aTargetPos;\n"
+"layout(location = 2) in mat4 aTransform;\n"
+"layout(location = 6) in vec4 aColor;\n"
+"layout(location = 7) in float aMorph;\n"
+"out vec4 vColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = viewProjection * (aTransform * vec4(mix(aPos, aTargetPos, aMorph), 1.0));\n"
+"   vColor = aColor;\n"
+"}\0";
+
+// Instanced circles and rings drawn as one quad each (see Instancing.h): the corners come from
+// gl_VertexID, so no vertex buffer is needed. The quad covers the circle plus two pixels
+// (frameParams.yz) for the anti-aliased edge. Pair with circleFragmentShaderSource.
+inline const char* const circleVertexShaderSource = "#version 330 core\n"
+GLCORE_UNIFORM_BLOCKS_GLSL
+"layout(location = 1) in mat4 aTransform;\n"
+"layout(location = 5) in vec4 aColor;\n"
+"layout(location = 6) in vec2 aCircle;\n"
+"out vec2 vLocal;\n"
+"flat out vec2 vCircle;\n"
+"flat out vec4 vColor;\n"
+"void main()\n"
+"{\n"
+"   vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;\n"
+"   float scale = max(length((vec4(1.0, 0.0, 0.0, 0.0) * aTransform).xy), 1e-6);\n"
+"   float margin = 2.0 * max(frameParams.y, frameParams.z) / scale;\n"
+"   vLocal = corner * (aCircle.x + 0.5 * aCircle.y + margin);\n"
+"   gl_Position = vec4(vLocal, 0.0, 1.0) * aTransform;\n"
+"   vCircle = aCircle;\n"
+"   vColor = aColor;\n"
+"}\0";
+
+// Signed distance to the circle (or to the ring when the thickness is not 0), turned into
+// coverage over one pixel's distance change for analytic anti-aliasing. Needs alpha blending.
+inline const char* const circleFragmentShaderSource = "#version 330 core\n"
+"in vec2 vLocal;\n"
+"flat in vec2 vCircle;\n"
+"flat in vec4 vColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   float distance = length(vLocal) - vCircle.x;\n"
+"   if (vCircle.y > 0.0) {\n"
+"       distance = abs(distance) - 0.5 * vCircle.y;\n"
+"   }\n"
+"   float coverage = clamp(0.5 - distance / max(fwidth(distance), 1e-6), 0.0, 1.0);\n"
+"   if (coverage <= 0.0) {\n"
+"       discard;\n"
+"   }\n"
+"   FragColor = vec4(vColor.rgb, vColor.a * coverage);\n"
+"}\n\0";
+
+// Procedural polygons with no vertex buffer (see Procedural.h): every instance record holds a
+// center, radius, angle, side count and spin, and gl_VertexID picks the fan triangle and corner.
+inline const char* const proceduralVertexShaderSource = "#version 330 core\n"
+GLCORE_UNIFORM_BLOCKS_GLSL
+"layout(location = 0) in vec4 aShape;\n"
+"layout(location = 1) in vec4 aColor;\n"
+"layout(location = 2) in vec2 aParams;\n"
+"out vec4 vColor;\n"
+"void main()\n"
+"{\n"
+"   int segments = int(aParams.x + 0.5);\n"
+"   int triangle = gl_VertexID / 3;\n"
+"   int corner = gl_VertexID - triangle * 3;\n"
+"   vec2 position = aShape.xy;\n"
+"   if (triangle < segments && corner > 0) {\n"
+"       float angle = radians(aShape.w + aParams.y * frameParams.x) + 6.2831853 * float(triangle + corner - 1) / float(segments);\n"
+"       position += aShape.z * vec2(cos(angle), sin(angle));\n"
+"   }\n"
+"   gl_Position = viewProjection * vec4(position, 0.0, 1.0);\n"
+"   vColor = aColor;\n"
+"}\0";
+
+// Fragment shader filling with the color passed down from the vertex shader
+inline const char* const vertexColorFragmentShaderSource = "#version 330 core\n"
+"in vec4 vColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = vColor;\n"
+"}\n\0";
+
+// Compiles one shader stage, prints the info log and returns 0 on failure
+GLuint compileShader(GLenum type, const char* source);
+
+// Compiles and links a vertex + fragment program, prints the info log and returns 0 on failure.
+// The shader objects are deleted once linked and the uniform blocks are bound (bindUniformBlocks).
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource);
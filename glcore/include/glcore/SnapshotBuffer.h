@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+// Lock-free handoff of whole frame snapshots from one producer thread to one consumer thread.
+// The producer fills beginWrite() and publishes it; the consumer takes the newest published
+// snapshot with acquire(). Three slots (one being written, one being read, one in between) let
+// both sides work at the same time without a lock: handing a slot over is a single atomic
+// exchange of the in-between slot's index. A snapshot published before the consumer took the
+// previous one replaces it, so wait on isPending() first when every frame has to be drawn.
+template <typename T>
+class SnapshotBuffer {
+public:
+    // Slot to fill with the next snapshot; stays the same until publish()
+    T& beginWrite() { return slots[writeIndex]; }
+
+    // Hands the filled slot to the consumer and moves on to a free one
+    void publish() {
+        int previous = shared.exchange(writeIndex | freshBit, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    // True while a published snapshot has not been taken by the consumer yet
+    bool isPending() const { return (shared.load(std::memory_order_acquire) & freshBit) != 0; }
+
+    // Newest published snapshot, or nullptr when nothing was published since the last call.
+    // The snapshot stays valid and unchanged until the next successful acquire().
+    const T* acquire() {
+        if (!isPending()) {
+            return nullptr;
+        }
+        int previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return &slots[readIndex];
+    }
+
+private:
+    static const int indexMask = 3;
+    static const int freshBit = 4;
+
+    T slots[3];
+    std::atomic<int> shared{ 1 };
+    int writeIndex = 0; // producer only
+    int readIndex = 2;  // consumer only
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Bind calls that reached GL versus those skipped because the state already matched
+struct StateCacheStats {
+    long long issued = 0;
+    long long skipped = 0;
+};
+
+// Tracks the program, VAO, buffer bindings and uniform buffer ranges of the current context and
+// only forwards calls that change them. Code that binds through GL directly must call invalidate()
+// afterwards (or the matching invalidate*) so the cache does not skip a needed call.
+// The element array binding is VAO state, so it is forgotten whenever the VAO changes.
+class StateCache {
+public:
+    StateCache() { invalidate(); }
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vertexArray);
+    void bindBuffer(GLenum target, GLuint buffer);
+
+    // Indexed binding; ranges of GL_UNIFORM_BUFFER binding points below 8 are tracked
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    // Forget an object that is being deleted: GL may hand its name to a new object, which must
+    // not be taken for the one still cached as bound
+    void forgetVertexArray(GLuint vertexArray);
+    void forgetBuffer(GLuint buffer);
+
+    // Forgets everything, for use after GL calls that bypassed the cache
+    void invalidate();
+    void invalidateBuffer(GLenum target);
+
+    const StateCacheStats& getStats() const { return stats; }
+    void resetStats() { stats = StateCacheStats(); }
+
+private:
+    struct BufferRange {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    // Binding value meaning "not known", e.g. after invalidate()
+    static constexpr GLuint unknown = 0xFFFFFFFFu;
+
+    // Slot of a tracked buffer target, -1 for targets that are always forwarded
+    static int bufferSlot(GLenum target);
+
+    // Counts a call and returns skip
+    bool count(bool skip);
+
+    GLuint program = unknown;
+    GLuint vertexArray = unknown;
+    GLuint buffers[3] = { unknown, unknown, unknown };
+    BufferRange uniformRanges[8];
+    StateCacheStats stats;
+};
+
+// Cache of the current context, reset by Context::create
+StateCache& getStateCache();
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+// Upload counters of a StreamBuffer
+struct StreamStats {
+    size_t frameBytes = 0;  // bytes allocated since the last beginFrame()
+    int frameWaits = 0;     // fence waits that blocked in the last beginFrame()
+    size_t totalBytes = 0;
+    int totalWaits = 0;
+    int frames = 0;
+};
+
+// Ring buffer for data rewritten every frame (dynamic vertices, per-instance attributes).
+// The buffer is split into regionCount regions of frameCapacity bytes; each frame writes into the
+// next region and fences it, so the CPU only waits when it laps a region the GPU still reads.
+// With ARB_buffer_storage the whole buffer stays persistently mapped; without it every frame
+// orphans the buffer and maps it again, letting the driver hand out fresh storage.
+//
+// Per frame: beginFrame(), allocate() and write, flush(), then draw from the returned offsets.
+class StreamBuffer {
+public:
+    StreamBuffer() = default;
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+    ~StreamBuffer();
+
+    // Creates the buffer, persistently mapped unless allowPersistent is false or unsupported.
+    // Prints the reason and returns false on failure.
+    bool create(GLsizeiptr frameCapacity, int regionCount = 3, bool allowPersistent = true);
+    void destroy();
+
+    // Fences the previous frame's region and moves to the next one, waiting if it is still in use
+    void beginFrame();
+
+    // Reserves size bytes in the current frame and returns where to write them, or nullptr if the
+    // frame is full. offset receives the byte offset in getBuffer() to draw from.
+    void* allocate(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment = 16);
+
+    // Copies size bytes into the current frame and returns their offset, or -1 if the frame is full
+    GLintptr upload(const void* data, GLsizeiptr size, GLsizeiptr alignment = 16);
+
+    // Makes this frame's writes visible to GL; call before drawing from them
+    void flush();
+
+    GLuint getBuffer() const { return buffer; }
+    GLsizeiptr getFrameCapacity() const { return frameCapacity; }
+    bool isPersistent() const { return persistent; }
+    const StreamStats& getStats() const { return stats; }
+
+private:
+    GLuint buffer = 0;
+    GLsizeiptr frameCapacity = 0;
+    int regionCount = 0;
+    bool persistent = false;
+
+    int region = -1;          // region written this frame, -1 before the first beginFrame()
+    GLsizeiptr used = 0;      // bytes allocated in the current region
+    char* mapped = nullptr;   // start of the mapping, the whole buffer when persistent
+    GLsync fences[8] = {};
+    StreamStats stats;
+};
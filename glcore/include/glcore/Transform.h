@@ -0,0 +1,14 @@
+#pragma once
+
+// 4x4 matrices as float[16]. Elements are written row by row and uploaded with
+// glUniformMatrix4fv(..., GL_FALSE, ...), which is the layout every demo relies on.
+// These are the original scalar helpers, kept as the reference for Mat4.h.
+
+// Function to create rotation matrix around z, angle in degrees
+void createRotationMatrix(float* matrix, float angle);
+
+// Function to create translation matrix
+void createTranslationMatrix(float* matrix, float x, float y, float z);
+
+// result = a * b, result must not alias a or b
+void multiplyMatrices(const float* a, const float* b, float* result);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glcore/Mat4.h>
+
+#include <vector>
+
+// Structure-of-arrays inputs for a population of 2D objects
+struct TransformBatch {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> angle; // degrees, counter-clockwise like rotationZ
+    std::vector<float> scale;
+
+    void resize(int count);
+    int size() const { return (int)x.size(); }
+};
+
+// Writes compose(x[i], y[i], 0, angle[i], scale[i]) for every i in [begin, end) to out[i].
+// Processes 4 (SSE2) or 8 (AVX2) objects per step with a polynomial sin/cos. Angles are
+// wrapped to [-180, 180] first, so precision does not degrade as animations run for hours.
+// out must hold at least end matrices.
+void computeTransforms(const TransformBatch& batch, Mat4* out, int begin, int end);
+
+// Vectorized sine and cosine of count angles in radians. Angles are wrapped to [-pi, pi] first, so
+// raw animation phases need no wrapping: accurate to about 1.5e-7 for |x| < 4e4 and to a few 1e-6
+// up to 4e5 (measured against double precision on the float input).
+void sinCos(const float* radians, float* sines, float* cosines, int count);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glcore/Mat4.h>
+#include <glcore/StreamBuffer.h>
+#include <glad/glad.h>
+
+// std140 uniform blocks shared by the shape shaders. The C++ structs mirror the GLSL layout
+// below: every member is a vec4 or mat4, so std140 adds no padding. Matrices are the row-major
+// Mat4 data, read by GLSL's column-major mat4 exactly as glUniformMatrix4fv(..., GL_FALSE) did.
+#define GLCORE_UNIFORM_BLOCKS_GLSL \
+"layout(std140) uniform FrameData {\n" \
+"   mat4 viewProjection;\n" \
+"   vec4 background;\n" \
+"   vec4 frameParams;\n" /* x = time in seconds, yz = size of one pixel in clip space */ \
+"};\n" \
+"layout(std140) uniform DrawData {\n" \
+"   mat4 transform;\n" \
+"   vec4 color;\n" \
+"   vec4 drawParams;\n" /* x = morph weight */ \
+"};\n"
+
+// Binding points the blocks are attached to by createShaderProgram
+const GLuint frameBlockBinding = 0;
+const GLuint drawBlockBinding = 1;
+
+struct alignas(16) FrameUniforms {
+    float viewProjection[16];
+    float background[4];
+    float time;
+    float pixelSize[2];
+    float frameParamsPadding;
+};
+
+struct alignas(16) DrawUniforms {
+    float transform[16];
+    float color[4];
+    float morph;
+    float drawParamsPadding[3];
+};
+
+inline void setMatrix(float* target, const Mat4& matrix) {
+    for (int i = 0; i < 16; ++i) {
+        target[i] = matrix.m[i];
+    }
+}
+
+inline void setColor(float* target, float r, float g, float b, float a) {
+    target[0] = r;
+    target[1] = g;
+    target[2] = b;
+    target[3] = a;
+}
+
+// Attaches the FrameData and DrawData blocks of program, where present, to their binding points
+void bindUniformBlocks(GLuint program);
+
+// Frame constants plus one DrawUniforms block per draw, written into a StreamBuffer in a single
+// pass each frame. Each draw then only rebinds its range of the buffer instead of setting its
+// uniforms one call at a time.
+//
+// Per frame: beginFrame(drawCount), fill getFrame() and getDraw(i), flush(), then bindDraw(i)
+// before each draw.
+class UniformStream {
+public:
+    // minAlignment raises the block alignment above the driver's GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    // (tests use it to get the 256-byte strides of desktop drivers on llvmpipe)
+    bool create(int maxDraws, bool allowPersistent = true, GLint minAlignment = 0);
+    void destroy();
+
+    // Reserves the frame block and drawCount draw blocks; returns false if maxDraws is exceeded
+    bool beginFrame(int drawCount);
+    FrameUniforms& getFrame() { return *frame; }
+    DrawUniforms& getDraw(int index) { return *(DrawUniforms*)(draws + index * drawStride); }
+
+    // Makes the writes visible and binds the frame block
+    void flush();
+    void bindDraw(int index);
+
+    const StreamStats& getStats() const { return stream.getStats(); }
+
+private:
+    StreamBuffer stream;
+    int maxDraws = 0;
+    GLsizeiptr alignment = 0;
+    GLsizeiptr frameStride = 0;
+    GLsizeiptr drawStride = 0; // sizeof(DrawUniforms) rounded up to the uniform offset alignment
+    FrameUniforms* frame = nullptr;
+    char* draws = nullptr;
+    GLintptr frameOffset = 0;
+    GLintptr drawOffset = 0;
+};
@@ -0,0 +1,50 @@
+#include <glcore/Clock.h>
+
+#include <cstring>
+#include <thread>
+
+void Clock::start(ClockMode clockMode, double rate) {
+    mode = clockMode;
+    step = rate > 0.0 ? 1.0 / rate : 1.0 / 60.0;
+    frame = 0;
+    startTime = std::chrono::steady_clock::now();
+}
+
+double Clock::getTime() const {
+    return getFrameTime(frame.load(std::memory_order_acquire));
+}
+
+double Clock::getFrameTime(long long frameNumber) const {
+    if (mode == realtimeClock) {
+        return getElapsed();
+    }
+    return frameNumber * step;
+}
+
+void Clock::endFrame() {
+    long long next = frame.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (mode == fixedClock) {
+        std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(next * step)));
+    }
+}
+
+double Clock::getElapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool parseClockMode(const char* text, ClockMode& mode) {
+    if (std::strcmp(text, "realtime") == 0) {
+        mode = realtimeClock;
+    }
+    else if (std::strcmp(text, "fixed") == 0) {
+        mode = fixedClock;
+    }
+    else if (std::strcmp(text, "fast") == 0) {
+        mode = fastClock;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
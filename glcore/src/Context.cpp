@@ -0,0 +1,353 @@
+#include <glcore/Context.h>
+
+#include <glcore/CpuProfiler.h>
+#include <glcore/Extensions.h>
+#include <glcore/GpuProfiler.h>
+#include <glcore/StateCache.h>
+#include <glad/glad.h>
+
+#include <iostream>
+
+#ifdef GLCORE_HAS_GLFW
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#endif
+
+#ifdef GLCORE_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+// Backend of the most recently created context, used by getGLProcAddress
+static bool headlessBackend = false;
+
+Context::~Context() {
+    destroy();
+}
+
+bool Context::create(const AppOptions& options, const char* title) {
+    headless = options.headless;
+    width = options.width;
+    height = options.height;
+    surfaceWidth = width;
+    surfaceHeight = height;
+    maxFrames = options.frames;
+    frameCount = 0;
+    tracePath = options.tracePath;
+    CpuProfiler::setThreadName("main");
+    if (tracePath) {
+        getCpuProfiler().enable();
+    }
+
+    bool created = headless ? createHeadless() : createWindow(title);
+    if (!created) {
+        return false;
+    }
+
+    headlessBackend = headless;
+#ifdef GLCORE_HAS_GLFW
+    if (window && options.clock == fastClock) {
+        glfwSwapInterval(0); // measure throughput, not the display's refresh rate
+    }
+#endif
+    clock.start(options.clock, options.clockRate);
+    if (!gladLoadGLLoader((GLADloadproc)getGLProcAddress)) {
+        std::cout << "Failed to load OpenGL functions" << std::endl;
+        destroy();
+        return false;
+    }
+    loadExtensions();
+    getStateCache().invalidate();
+    getStateCache().resetStats();
+    if (options.dumpPath && !createDump(options)) {
+        destroy();
+        return false;
+    }
+    // The stats take their GPU frame times from the profiler's whole-frame span
+    gpuReport = options.gpuProfile;
+    if (options.gpuProfile || options.statsInterval > 0.0) {
+        getGpuProfiler().enable();
+        gpuFramesSeen = 0;
+    }
+    lastPresent = clock.getElapsed();
+    if (options.statsInterval > 0.0 && !stats.start(options.statsInterval, 1000.0 / options.clockRate, options.statsCsv, lastPresent)) {
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+bool Context::createDump(const AppOptions& options) {
+    int targetWidth = options.dumpWidth > 0 ? options.dumpWidth : surfaceWidth;
+    int targetHeight = options.dumpHeight > 0 ? options.dumpHeight : surfaceHeight;
+    if (!offscreen.create(targetWidth, targetHeight) || !dumper.create(options.dumpPath, targetWidth, targetHeight)) {
+        return false;
+    }
+    // Demos draw into the offscreen target at its own resolution from here on
+    offscreen.bind();
+    width = targetWidth;
+    height = targetHeight;
+    dumpEvery = options.dumpEvery;
+    return true;
+}
+
+bool Context::createWindow(const char* title) {
+#ifdef GLCORE_HAS_GLFW
+    if (!glfwInit()) {
+        std::cout << "Failed to initialize GLFW" << std::endl;
+        return false;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE); // required on Mac
+
+    window = glfwCreateWindow(width, height, title, nullptr, nullptr);
+    if (window == nullptr) {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(window);
+    return true;
+#else
+    (void)title;
+    std::cout << "This build has no windowed backend, run with --headless" << std::endl;
+    return false;
+#endif
+}
+
+bool Context::createHeadless() {
+#ifdef GLCORE_HAS_EGL
+    // Prefer the Mesa surfaceless platform so no X11/Wayland connection is attempted
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major = 0, minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::cout << "Failed to initialize EGL display (error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        std::cout << "No EGL pbuffer config with desktop OpenGL support" << std::endl;
+        eglTerminate(display);
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cout << "EGL cannot bind the desktop OpenGL API" << std::endl;
+        eglTerminate(display);
+        return false;
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (context == EGL_NO_CONTEXT) {
+        std::cout << "Failed to create EGL context (error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        eglTerminate(display);
+        return false;
+    }
+
+    const EGLint surfaceAttributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE || !eglMakeCurrent(display, surface, surface, context)) {
+        std::cout << "Failed to make the EGL pbuffer current (error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        return false;
+    }
+
+    eglDisplay = display;
+    eglSurface = surface;
+    eglContext = context;
+    return true;
+#else
+    std::cout << "This build has no headless backend (EGL was not found)" << std::endl;
+    return false;
+#endif
+}
+
+void Context::destroy() {
+    stats.finish(clock.getElapsed());
+    if (getGpuProfiler().isEnabled()) {
+        if (gpuReport) {
+            getGpuProfiler().report();
+        }
+        getGpuProfiler().disable();
+    }
+    if (dumper.isActive()) {
+        dumper.finish();
+        std::cout << "Dumped " << dumper.getWritten() << " frames at " << width << "x" << height;
+        if (dumper.getFailed() > 0) {
+            std::cout << ", " << dumper.getFailed() << " failed";
+        }
+        std::cout << " (" << dumper.getStalls() << " writer stalls)" << std::endl;
+    }
+    offscreen.destroy();
+    // After the dump so the writer thread's last frames are in the trace
+    if (tracePath) {
+        getCpuProfiler().writeTrace(tracePath);
+        tracePath = nullptr;
+    }
+#ifdef GLCORE_HAS_GLFW
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        window = nullptr;
+    }
+#endif
+#ifdef GLCORE_HAS_EGL
+    if (eglDisplay) {
+        // Wait for the GPU so the reported throughput includes all submitted work. Contexts that
+        // never presented a frame (tests, benchmarks) have nothing to report.
+        eglWaitClient();
+        if (frameCount > 0) {
+            double seconds = clock.getElapsed();
+            std::cout << "Rendered " << frameCount << " frames in " << seconds << " s ("
+                << (seconds > 0.0 ? frameCount / seconds : 0.0) << " fps)" << std::endl;
+            const StateCacheStats& cacheStats = getStateCache().getStats();
+            if (cacheStats.issued + cacheStats.skipped > 0) {
+                std::cout << "State cache skipped " << cacheStats.skipped << " of "
+                    << cacheStats.issued + cacheStats.skipped << " bind calls" << std::endl;
+            }
+        }
+
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroySurface(eglDisplay, eglSurface);
+        eglDestroyContext(eglDisplay, eglContext);
+        eglTerminate(eglDisplay);
+        eglDisplay = nullptr;
+        eglSurface = nullptr;
+        eglContext = nullptr;
+    }
+#endif
+}
+
+bool Context::shouldClose() {
+    if (maxFrames > 0 && frameCount >= maxFrames) {
+        return true;
+    }
+#ifdef GLCORE_HAS_GLFW
+    if (window) {
+        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+            glfwSetWindowShouldClose(window, true);
+        }
+        return glfwWindowShouldClose(window);
+    }
+#endif
+    return false;
+}
+
+void Context::pollEvents() {
+    CpuScope scope("poll events");
+#ifdef GLCORE_HAS_GLFW
+    if (window) {
+        glfwPollEvents();
+    }
+#endif
+}
+
+void Context::swapBuffers() {
+    CpuScope scope("swap buffers");
+    double swapStart = clock.getElapsed();
+    {
+        GpuScope gpuScope("present");
+        if (offscreen.isCreated()) {
+            if (frameCount % dumpEvery == 0) {
+                CpuScope readback("frame readback");
+                dumper.capture(frameCount);
+            }
+            if (window) {
+                offscreen.blitToDefault(surfaceWidth, surfaceHeight);
+            }
+        }
+        ++frameCount;
+#ifdef GLCORE_HAS_GLFW
+        if (window) {
+            glfwSwapBuffers(window);
+        }
+#endif
+#ifdef GLCORE_HAS_EGL
+        if (eglDisplay) {
+            eglSwapBuffers(eglDisplay, eglSurface);
+        }
+#endif
+    }
+    GpuProfiler& profiler = getGpuProfiler();
+    profiler.nextFrame();
+    clock.endFrame();
+
+    if (stats.isEnabled()) {
+        double now = clock.getElapsed();
+        stats.recordFrame((swapStart - lastPresent) * 1000.0, (now - lastPresent) * 1000.0);
+        if (profiler.getCollectedFrames() != gpuFramesSeen) {
+            gpuFramesSeen = profiler.getCollectedFrames();
+            stats.recordGpu(profiler.getLastFrameMilliseconds());
+        }
+        stats.update(now);
+        lastPresent = now;
+    }
+}
+
+void Context::makeCurrent() {
+#ifdef GLCORE_HAS_GLFW
+    if (window) {
+        glfwMakeContextCurrent(window);
+    }
+#endif
+#ifdef GLCORE_HAS_EGL
+    if (eglDisplay) {
+        eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext);
+    }
+#endif
+}
+
+void Context::releaseCurrent() {
+#ifdef GLCORE_HAS_GLFW
+    if (window) {
+        glfwMakeContextCurrent(nullptr);
+    }
+#endif
+#ifdef GLCORE_HAS_EGL
+    if (eglDisplay) {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+#endif
+}
+
+void* getGLProcAddress(const char* name) {
+#ifdef GLCORE_HAS_EGL
+    if (headlessBackend) {
+        return (void*)eglGetProcAddress(name);
+    }
+#endif
+#ifdef GLCORE_HAS_GLFW
+    return (void*)glfwGetProcAddress(name);
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
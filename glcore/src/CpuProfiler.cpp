@@ -0,0 +1,90 @@
+#include <glcore/CpuProfiler.h>
+
+#include <cstdio>
+#include <iostream>
+
+static CpuProfiler cpuProfiler;
+
+// Ring of the calling thread, and its name until the ring exists
+static thread_local void* threadRing = nullptr;
+static thread_local const char* threadName = nullptr;
+
+CpuProfiler& getCpuProfiler() {
+    return cpuProfiler;
+}
+
+void CpuProfiler::enable(int ringCapacity) {
+    capacity = ringCapacity > 0 ? ringCapacity : 1;
+    startTime = std::chrono::steady_clock::now();
+    enabled.store(true, std::memory_order_release);
+}
+
+void CpuProfiler::setThreadName(const char* name) {
+    threadName = name;
+    if (threadRing) {
+        ((ThreadRing*)threadRing)->name.store(name, std::memory_order_release);
+    }
+}
+
+int64_t CpuProfiler::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+CpuProfiler::ThreadRing& CpuProfiler::getRing() {
+    if (threadRing == nullptr) {
+        std::unique_ptr<ThreadRing> ring = std::make_unique<ThreadRing>();
+        ring->events.resize(capacity);
+        ring->name.store(threadName, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        ring->id = (int)rings.size() + 1;
+        threadRing = ring.get();
+        rings.push_back(std::move(ring));
+    }
+    return *(ThreadRing*)threadRing;
+}
+
+void CpuProfiler::record(const char* name, int64_t begin, int64_t end) {
+    ThreadRing& ring = getRing();
+    uint64_t index = ring.written.load(std::memory_order_relaxed);
+    ring.events[index % ring.events.size()] = Event{ name, begin, end };
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+bool CpuProfiler::writeTrace(const char* path) const {
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        std::cout << "ERROR::CPU_PROFILER::CANNOT_WRITE " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    uint64_t total = 0, dropped = 0;
+    for (const std::unique_ptr<ThreadRing>& ring : rings) {
+        const char* name = ring->name.load(std::memory_order_acquire);
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", ring->id, name ? name : "thread");
+        first = false;
+
+        // Oldest surviving event first; a full ring has overwritten the ones before it
+        uint64_t written = ring->written.load(std::memory_order_acquire);
+        uint64_t size = ring->events.size();
+        uint64_t start = written > size ? written - size : 0;
+        for (uint64_t i = start; i < written; ++i) {
+            const Event& event = ring->events[i % size];
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                event.name, ring->id, event.begin / 1000.0, (event.end - event.begin) / 1000.0);
+        }
+        total += written - start;
+        dropped += start;
+    }
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::fclose(file) == 0;
+    std::cout << "Wrote " << total << " CPU scopes from " << rings.size() << " thread(s) to " << path;
+    if (dropped > 0) {
+        std::cout << " (" << dropped << " oldest dropped)";
+    }
+    std::cout << std::endl;
+    return ok;
+}
@@ -0,0 +1,44 @@
+#include <glcore/Extensions.h>
+
+#include <glcore/Context.h>
+
+#include <cstring>
+
+static GLExtensions extensions;
+
+bool hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (extension && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// True if the context version is at least major.minor
+static bool hasVersion(int major, int minor) {
+    GLint contextMajor = 0, contextMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+    return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+void loadExtensions() {
+    extensions = GLExtensions();
+
+    if (hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage")) {
+        extensions.bufferStorageProc = (PFNGLBUFFERSTORAGEPROC)getGLProcAddress("glBufferStorage");
+        extensions.bufferStorage = extensions.bufferStorageProc != nullptr;
+    }
+    if (hasVersion(4, 3) || (hasExtension("GL_ARB_multi_draw_indirect") && hasExtension("GL_ARB_base_instance"))) {
+        extensions.multiDrawArraysIndirectProc = (PFNGLMULTIDRAWARRAYSINDIRECTPROC)getGLProcAddress("glMultiDrawArraysIndirect");
+        extensions.multiDrawIndirect = extensions.multiDrawArraysIndirectProc != nullptr;
+    }
+}
+
+const GLExtensions& getExtensions() {
+    return extensions;
+}
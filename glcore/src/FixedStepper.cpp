@@ -0,0 +1,42 @@
+#include <glcore/FixedStepper.h>
+
+// Slack when comparing the accumulator with the step, so frame times that are exact multiples
+// of the step (fixed clocks, vsync) do not lose a tick to rounding
+static const double stepEpsilon = 1e-9;
+
+FixedStepper::FixedStepper(double step, int maxTicksPerFrame)
+    : step(step > 0.0 ? step : 1.0 / 60.0), maxTicksPerFrame(maxTicksPerFrame > 0 ? maxTicksPerFrame : 1) {
+}
+
+void FixedStepper::reset(double now) {
+    lastTime = now;
+    accumulator = 0.0;
+    started = true;
+}
+
+int FixedStepper::advance(double now) {
+    if (!started) {
+        reset(now);
+    }
+    double elapsed = now - lastTime;
+    lastTime = now;
+    if (elapsed > 0.0) {
+        accumulator += elapsed;
+    }
+
+    int count = 0;
+    while (accumulator + stepEpsilon >= step) {
+        accumulator -= step;
+        if (count < maxTicksPerFrame) {
+            ++count;
+        }
+        else {
+            ++droppedTicks;
+        }
+    }
+    if (accumulator < 0.0) {
+        accumulator = 0.0;
+    }
+    ticks += count;
+    return count;
+}
@@ -0,0 +1,238 @@
+#include <glcore/FrameDump.h>
+
+#include <glcore/CpuProfiler.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef GLCORE_HAS_PNG
+#include <png.h>
+#endif
+
+// Frames waiting for the writer before capture() blocks, bounding the memory a slow disk can take
+static const size_t maxQueuedImages = 4;
+
+bool isFramePattern(const char* pattern) {
+    int conversions = 0;
+    for (const char* c = pattern; *c; ++c) {
+        if (*c != '%') {
+            continue;
+        }
+        ++c;
+        if (*c == '%') {
+            continue;
+        }
+        while (*c && std::strchr("-+ #0", *c)) {
+            ++c;
+        }
+        while (*c >= '0' && *c <= '9') {
+            ++c;
+        }
+        if (*c == '.') {
+            ++c;
+            while (*c >= '0' && *c <= '9') {
+                ++c;
+            }
+        }
+        // No length modifiers: the frame number is passed as an int
+        if (*c == '\0' || !std::strchr("diouxX", *c)) {
+            return false;
+        }
+        ++conversions;
+    }
+    return conversions == 1;
+}
+
+FrameDumper::~FrameDumper() {
+    finish();
+}
+
+bool FrameDumper::create(const char* pathPattern, int imageWidth, int imageHeight) {
+    finish();
+    if (!isFramePattern(pathPattern)) {
+        std::cout << "ERROR::FRAME_DUMP::BAD_PATTERN " << pathPattern << " (needs exactly one %d)" << std::endl;
+        return false;
+    }
+    pattern = pathPattern;
+    png = pattern.size() >= 4 && pattern.compare(pattern.size() - 4, 4, ".png") == 0;
+#ifndef GLCORE_HAS_PNG
+    if (png) {
+        std::cout << "ERROR::FRAME_DUMP::PNG_UNSUPPORTED (built without libpng, use a .ppm path)" << std::endl;
+        return false;
+    }
+#endif
+    width = imageWidth;
+    height = imageHeight;
+
+    glGenBuffers(2, pixelBuffers);
+    for (GLuint buffer : pixelBuffers) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 4, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pendingFrame[0] = pendingFrame[1] = -1;
+    nextSlot = 0;
+    stalls = 0;
+    written = 0;
+    failed = 0;
+    stopping = false;
+    writer = std::thread(&FrameDumper::writerLoop, this);
+    return true;
+}
+
+void FrameDumper::capture(int frame) {
+    if (!isActive()) {
+        return;
+    }
+    // Start this frame's readback; glReadPixels into a bound pack buffer returns immediately
+    int slot = nextSlot;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[slot]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pendingFrame[slot] = frame;
+
+    // The previous capture has had a whole frame to complete
+    nextSlot = 1 - slot;
+    if (pendingFrame[nextSlot] >= 0) {
+        collect(nextSlot);
+    }
+}
+
+void FrameDumper::collect(int slot) {
+    Image image;
+    char path[1024];
+    std::snprintf(path, sizeof(path), pattern.c_str(), pendingFrame[slot]);
+    image.path = path;
+    image.pixels.resize((size_t)width * height * 4);
+    pendingFrame[slot] = -1;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[slot]);
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, image.pixels.size(), GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(image.pixels.data(), mapped, image.pixels.size());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!mapped) {
+        std::cout << "ERROR::FRAME_DUMP::MAP_FAILED" << std::endl;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (queue.size() >= maxQueuedImages) {
+        ++stalls;
+        queueChanged.wait(lock, [this]() { return queue.size() < maxQueuedImages; });
+    }
+    queue.push_back(std::move(image));
+    queueChanged.notify_all();
+}
+
+void FrameDumper::finish() {
+    if (!isActive()) {
+        return;
+    }
+    if (pendingFrame[nextSlot] >= 0) {
+        collect(nextSlot);
+    }
+    if (pendingFrame[1 - nextSlot] >= 0) {
+        collect(1 - nextSlot);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    writer.join();
+
+    glDeleteBuffers(2, pixelBuffers);
+    pixelBuffers[0] = pixelBuffers[1] = 0;
+}
+
+void FrameDumper::writerLoop() {
+    CpuProfiler::setThreadName("frame writer");
+    for (;;) {
+        Image image;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            image = std::move(queue.front());
+            queue.pop_front();
+        }
+        queueChanged.notify_all();
+        CpuScope scope(png ? "encode png" : "write ppm");
+        if (writeImage(image)) {
+            ++written;
+        }
+        else {
+            std::cout << "ERROR::FRAME_DUMP::WRITE_FAILED " << image.path << std::endl;
+            ++failed;
+        }
+    }
+}
+
+#ifdef GLCORE_HAS_PNG
+// Kept apart from writeImage so that no local of the caller is live across setjmp: on a libpng
+// error longjmp lands here and only the png structs, unchanged since setjmp, are used again
+static bool writePng(FILE* file, const unsigned char* rgb, int width, int height) {
+    png_structp writeStruct = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (writeStruct == nullptr) {
+        return false;
+    }
+    png_infop info = png_create_info_struct(writeStruct);
+    if (info == nullptr) {
+        png_destroy_write_struct(&writeStruct, nullptr);
+        return false;
+    }
+    if (setjmp(png_jmpbuf(writeStruct))) {
+        png_destroy_write_struct(&writeStruct, &info);
+        return false;
+    }
+    png_init_io(writeStruct, file);
+    png_set_IHDR(writeStruct, info, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    // Fast compression: the writer has to keep up with the frame rate
+    png_set_compression_level(writeStruct, 1);
+    png_write_info(writeStruct, info);
+    for (int y = 0; y < height; ++y) {
+        png_write_row(writeStruct, (png_const_bytep)&rgb[(size_t)y * width * 3]);
+    }
+    png_write_end(writeStruct, nullptr);
+    png_destroy_write_struct(&writeStruct, &info);
+    return true;
+}
+#endif
+
+bool FrameDumper::writeImage(const Image& image) {
+    // Top row first, RGB
+    std::vector<unsigned char> rgb((size_t)width * height * 3);
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* source = &image.pixels[(size_t)(height - 1 - y) * width * 4];
+        unsigned char* row = &rgb[(size_t)y * width * 3];
+        for (int x = 0; x < width; ++x) {
+            row[x * 3 + 0] = source[x * 4 + 0];
+            row[x * 3 + 1] = source[x * 4 + 1];
+            row[x * 3 + 2] = source[x * 4 + 2];
+        }
+    }
+
+    FILE* file = std::fopen(image.path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = true;
+    if (!png) {
+        std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+        ok = std::fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    }
+#ifdef GLCORE_HAS_PNG
+    else {
+        ok = writePng(file, rgb.data(), width, height);
+    }
+#endif
+    return std::fclose(file) == 0 && ok;
+}
@@ -0,0 +1,126 @@
+#include <glcore/FrameStats.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Percentiles of every histogram in the readout
+static const double reportedPercentiles[] = { 50.0, 95.0, 99.0 };
+
+FrameStats::~FrameStats() {
+    if (csv) {
+        std::fclose(csv);
+    }
+}
+
+bool FrameStats::start(double interval, double budget, const char* csvPath, double now) {
+    if (csvPath) {
+        csv = std::fopen(csvPath, "w");
+        if (!csv) {
+            std::cout << "ERROR::FRAME_STATS::CANNOT_OPEN " << csvPath << std::endl;
+            return false;
+        }
+        std::fprintf(csv, "time_s,frames,fps,missed");
+        for (const char* series : { "cpu", "gpu", "present" }) {
+            std::fprintf(csv, ",%s_p50_ms,%s_p95_ms,%s_p99_ms,%s_max_ms", series, series, series, series);
+        }
+        std::fprintf(csv, "\n");
+    }
+    intervalSeconds = interval;
+    budgetMilliseconds = budget;
+    startTime = now;
+    totalFrames = 0;
+    totalMissed = 0;
+    reset(now);
+    return true;
+}
+
+void FrameStats::finish(double now) {
+    if (!isEnabled()) {
+        return;
+    }
+    if (present.getCount() > 0) {
+        report(now);
+    }
+    std::ostringstream line;
+    line << "Frame stats: " << totalFrames << " frames, " << totalMissed << " missed the "
+        << std::fixed << std::setprecision(1) << budgetMilliseconds * 1.5 << " ms deadline";
+    std::cout << line.str() << std::endl;
+    if (csv) {
+        std::fclose(csv);
+        csv = nullptr;
+    }
+    intervalSeconds = 0.0;
+}
+
+void FrameStats::recordFrame(double cpuMilliseconds, double presentMilliseconds) {
+    if (!isEnabled()) {
+        return;
+    }
+    cpu.record((int64_t)(cpuMilliseconds * 1000.0));
+    present.record((int64_t)(presentMilliseconds * 1000.0));
+    if (presentMilliseconds > budgetMilliseconds * 1.5) {
+        ++missed;
+    }
+}
+
+void FrameStats::recordGpu(double milliseconds) {
+    if (isEnabled()) {
+        gpu.record((int64_t)(milliseconds * 1000.0));
+    }
+}
+
+void FrameStats::update(double now) {
+    if (isEnabled() && now - intervalStart >= intervalSeconds) {
+        report(now);
+    }
+}
+
+void FrameStats::report(double now) {
+    double seconds = now - intervalStart;
+    long long frames = present.getCount();
+    double fps = seconds > 0.0 ? frames / seconds : 0.0;
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2);
+    line << "[" << std::setprecision(1) << now - startTime << " s] " << frames << " frames, "
+        << fps << " fps, " << missed << " missed" << std::setprecision(2);
+    const char* names[] = { "cpu", "gpu", "present" };
+    const HdrHistogram* histograms[] = { &cpu, &gpu, &present };
+    if (csv) {
+        std::fprintf(csv, "%.3f,%lld,%.2f,%lld", now - startTime, frames, fps, missed);
+    }
+    for (int i = 0; i < 3; ++i) {
+        const HdrHistogram& histogram = *histograms[i];
+        if (histogram.getCount() > 0) {
+            line << " | " << names[i];
+            for (double percentile : reportedPercentiles) {
+                line << " p" << (int)percentile << " " << histogram.getPercentile(percentile) / 1000.0;
+            }
+            line << " max " << histogram.getMax() / 1000.0 << " ms";
+        }
+        if (csv) {
+            for (double percentile : reportedPercentiles) {
+                std::fprintf(csv, ",%.3f", histogram.getPercentile(percentile) / 1000.0);
+            }
+            std::fprintf(csv, ",%.3f", histogram.getMax() / 1000.0);
+        }
+    }
+    std::cout << line.str() << std::endl;
+    if (csv) {
+        std::fprintf(csv, "\n");
+        std::fflush(csv);
+    }
+
+    totalFrames += frames;
+    totalMissed += missed;
+    reset(now);
+}
+
+void FrameStats::reset(double now) {
+    intervalStart = now;
+    cpu.reset();
+    gpu.reset();
+    present.reset();
+    missed = 0;
+}
@@ -0,0 +1,200 @@
+#include <glcore/Geometry.h>
+
+#include <algorithm>
+#include <cmath>
+
+std::vector<GLfloat> generateCircleVertices(float centerX, float centerY, float radius, int segments) {
+    std::vector<GLfloat> vertices;
+    vertices.reserve(segments * 3);
+    for (int i = 0; i < segments; ++i) {
+        float angle = 2.0f * 3.14159f * i / segments;
+        float x = centerX + radius * std::cos(angle);
+        float y = centerY + radius * std::sin(angle);
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(0.0f); // z-coordinate (0 for 2D shape)
+    }
+    return vertices;
+}
+
+int adaptiveCircleSegments(float radiusPixels, float maxErrorPixels) {
+    if (maxErrorPixels <= 0.0f) {
+        return maxAdaptiveSegments;
+    }
+    if (radiusPixels <= maxErrorPixels) {
+        return minAdaptiveSegments;
+    }
+    // A chord over angle 2*pi/n sags radius * (1 - cos(pi/n)) below the arc
+    float needed = 3.14159f / std::acos(1.0f - maxErrorPixels / radiusPixels);
+    int segments = minAdaptiveSegments;
+    while (segments < needed && segments < maxAdaptiveSegments) {
+        segments *= 2;
+    }
+    return segments;
+}
+
+std::vector<GLfloat> generateCircleVertices(float centerX, float centerY, float radius, float radiusPixels, float maxErrorPixels) {
+    return generateCircleVertices(centerX, centerY, radius, adaptiveCircleSegments(radiusPixels, maxErrorPixels));
+}
+
+float lerp(float start, float end, float t) {
+    return start + t * (end - start);
+}
+
+float lerpAngle(float start, float end, float t) {
+    float delta = std::remainder(end - start, 360.0f);
+    return start + t * delta;
+}
+
+void interpolateVertices(const GLfloat* startVertices, const GLfloat* endVertices, GLfloat* result, float t, int vertexCount) {
+    for (int i = 0; i < vertexCount * 3; ++i) {
+        result[i] = lerp(startVertices[i], endVertices[i], t);
+    }
+}
+
+// Twice the signed area of an xyz outline in the xy plane, positive when counter-clockwise
+static float signedArea2(const std::vector<GLfloat>& outline) {
+    int count = (int)outline.size() / 3;
+    float area = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        int next = (i + 1) % count;
+        area += outline[i * 3] * outline[next * 3 + 1] - outline[next * 3] * outline[i * 3 + 1];
+    }
+    return area;
+}
+
+// Area centroid of a closed outline, vertex average when it has no area
+static void outlineCentroid(const std::vector<GLfloat>& outline, GLfloat* centroid) {
+    int count = (int)outline.size() / 3;
+    float area2 = signedArea2(outline);
+    float cx = 0.0f, cy = 0.0f, cz = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        cz += outline[i * 3 + 2] / count;
+    }
+    if (std::fabs(area2) > 1e-12f) {
+        for (int i = 0; i < count; ++i) {
+            int next = (i + 1) % count;
+            float cross = outline[i * 3] * outline[next * 3 + 1] - outline[next * 3] * outline[i * 3 + 1];
+            cx += (outline[i * 3] + outline[next * 3]) * cross;
+            cy += (outline[i * 3 + 1] + outline[next * 3 + 1]) * cross;
+        }
+        cx /= 3.0f * area2;
+        cy /= 3.0f * area2;
+    }
+    else {
+        for (int i = 0; i < count; ++i) {
+            cx += outline[i * 3] / count;
+            cy += outline[i * 3 + 1] / count;
+        }
+    }
+    centroid[0] = cx;
+    centroid[1] = cy;
+    centroid[2] = cz;
+}
+
+std::vector<GLfloat> resampleOutline(const GLfloat* vertices, int vertexCount, int sampleCount) {
+    if (sampleCount < vertexCount) {
+        sampleCount = vertexCount;
+    }
+
+    std::vector<float> lengths(vertexCount);
+    float perimeter = 0.0f;
+    for (int i = 0; i < vertexCount; ++i) {
+        const GLfloat* a = &vertices[i * 3];
+        const GLfloat* b = &vertices[((i + 1) % vertexCount) * 3];
+        lengths[i] = std::sqrt((b[0] - a[0]) * (b[0] - a[0]) + (b[1] - a[1]) * (b[1] - a[1]) + (b[2] - a[2]) * (b[2] - a[2]));
+        perimeter += lengths[i];
+    }
+
+    // Samples per edge by largest remainder, at least one (the edge's own corner)
+    std::vector<float> ideal(vertexCount);
+    std::vector<int> counts(vertexCount);
+    int assigned = 0;
+    for (int i = 0; i < vertexCount; ++i) {
+        ideal[i] = (perimeter > 0.0f) ? sampleCount * lengths[i] / perimeter : (float)sampleCount / vertexCount;
+        counts[i] = std::max(1, (int)ideal[i]);
+        assigned += counts[i];
+    }
+    while (assigned != sampleCount) {
+        int best = -1;
+        for (int i = 0; i < vertexCount; ++i) {
+            float deficit = ideal[i] - counts[i];
+            if (assigned < sampleCount) {
+                if (best < 0 || deficit > ideal[best] - counts[best]) {
+                    best = i;
+                }
+            }
+            else if (counts[i] > 1 && (best < 0 || deficit < ideal[best] - counts[best])) {
+                best = i;
+            }
+        }
+        counts[best] += (assigned < sampleCount) ? 1 : -1;
+        assigned += (assigned < sampleCount) ? 1 : -1;
+    }
+
+    std::vector<GLfloat> samples;
+    samples.reserve(sampleCount * 3);
+    for (int i = 0; i < vertexCount; ++i) {
+        const GLfloat* a = &vertices[i * 3];
+        const GLfloat* b = &vertices[((i + 1) % vertexCount) * 3];
+        for (int k = 0; k < counts[i]; ++k) {
+            float t = (float)k / counts[i];
+            samples.push_back(lerp(a[0], b[0], t));
+            samples.push_back(lerp(a[1], b[1], t));
+            samples.push_back(lerp(a[2], b[2], t));
+        }
+    }
+
+    // Counter-clockwise, keeping the first sample in place
+    if (signedArea2(samples) < 0.0f) {
+        for (int i = 1, j = sampleCount - 1; i < j; ++i, --j) {
+            for (int c = 0; c < 3; ++c) {
+                std::swap(samples[i * 3 + c], samples[j * 3 + c]);
+            }
+        }
+    }
+    return samples;
+}
+
+int morphVertexCount(int sampleCount) {
+    return sampleCount + 2;
+}
+
+std::vector<GLfloat> buildMorphTargets(const GLfloat* fromVertices, int fromCount, const GLfloat* toVertices, int toCount, int sampleCount) {
+    sampleCount = std::max(sampleCount, std::max(fromCount, toCount));
+    std::vector<GLfloat> from = resampleOutline(fromVertices, fromCount, sampleCount);
+    std::vector<GLfloat> to = resampleOutline(toVertices, toCount, sampleCount);
+
+    // Cyclic shift of the target that minimizes the total distance to the source samples
+    int bestShift = 0;
+    float bestCost = 0.0f;
+    for (int shift = 0; shift < sampleCount; ++shift) {
+        float cost = 0.0f;
+        for (int i = 0; i < sampleCount; ++i) {
+            int j = (i + shift) % sampleCount;
+            for (int c = 0; c < 3; ++c) {
+                float d = from[i * 3 + c] - to[j * 3 + c];
+                cost += d * d;
+            }
+        }
+        if (shift == 0 || cost < bestCost) {
+            bestCost = cost;
+            bestShift = shift;
+        }
+    }
+
+    std::vector<GLfloat> morph;
+    morph.reserve(morphVertexCount(sampleCount) * 6);
+    GLfloat fromCenter[3], toCenter[3];
+    outlineCentroid(from, fromCenter);
+    outlineCentroid(to, toCenter);
+    morph.insert(morph.end(), fromCenter, fromCenter + 3);
+    morph.insert(morph.end(), toCenter, toCenter + 3);
+    for (int n = 0; n <= sampleCount; ++n) {
+        int i = n % sampleCount;
+        int j = (i + bestShift) % sampleCount;
+        morph.insert(morph.end(), &from[i * 3], &from[i * 3] + 3);
+        morph.insert(morph.end(), &to[j * 3], &to[j * 3] + 3);
+    }
+    return morph;
+}
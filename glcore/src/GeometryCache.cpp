@@ -0,0 +1,35 @@
+#include <glcore/GeometryCache.h>
+
+#include <glcore/Geometry.h>
+
+MeshRange GeometryCache::getCircle(float radius, int segments) {
+    return get({ circleShape, radius, segments }, [radius, segments]() {
+        return generateCircleVertices(0.0f, 0.0f, radius, segments);
+    });
+}
+
+MeshRange GeometryCache::getAdaptiveCircle(float radius, float radiusPixels, float maxErrorPixels) {
+    return getCircle(radius, adaptiveCircleSegments(radiusPixels, maxErrorPixels));
+}
+
+MeshRange GeometryCache::get(const GeometryKey& key, const std::function<std::vector<GLfloat>()>& generate) {
+    auto found = meshes.find(key);
+    if (found != meshes.end()) {
+        ++hits;
+        return found->second;
+    }
+    ++misses;
+    std::vector<GLfloat> vertices = generate();
+    MeshRange range = arena.addMesh(vertices.data(), (int)(vertices.size() / 3));
+    meshes.emplace(key, range);
+    dirty = true;
+    return range;
+}
+
+void GeometryCache::flush() {
+    if (dirty) {
+        arena.upload();
+        ++uploads;
+        dirty = false;
+    }
+}
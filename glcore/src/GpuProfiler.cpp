@@ -0,0 +1,169 @@
+#include <glcore/GpuProfiler.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+static GpuProfiler gpuProfiler;
+
+GpuProfiler& getGpuProfiler() {
+    return gpuProfiler;
+}
+
+void GpuProfiler::enable(int frameLatency, int window) {
+    disable();
+    windowFrames = std::max(window, 1);
+    slots.resize(std::max(frameLatency, 2));
+    scopes.push_back(ScopeStats{ "frame", {}, 0 });
+    current = 0;
+    collectedFrames = 0;
+    lateFrames = 0;
+    lastFrameMilliseconds = 0.0f;
+    enabled = true;
+}
+
+void GpuProfiler::disable() {
+    for (FrameSlot& slot : slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries((GLsizei)slot.queries.size(), slot.queries.data());
+        }
+    }
+    slots.clear();
+    scopes.clear();
+    openMarkers.clear();
+    enabled = false;
+}
+
+int GpuProfiler::findScope(const char* name) {
+    for (size_t i = 1; i < scopes.size(); ++i) {
+        if (scopes[i].name == name || std::strcmp(scopes[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    scopes.push_back(ScopeStats{ name, {}, 0 });
+    return (int)scopes.size() - 1;
+}
+
+GLuint GpuProfiler::takeQuery() {
+    FrameSlot& slot = slots[current];
+    if (slot.usedQueries == (int)slot.queries.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        slot.queries.push_back(query);
+    }
+    GLuint query = slot.queries[slot.usedQueries++];
+    glQueryCounter(query, GL_TIMESTAMP);
+    return query;
+}
+
+void GpuProfiler::beginScope(const char* name) {
+    if (!enabled) {
+        return;
+    }
+    FrameSlot& slot = slots[current];
+    slot.markers.push_back(Marker{ findScope(name), takeQuery(), 0 });
+    openMarkers.push_back((int)slot.markers.size() - 1);
+}
+
+void GpuProfiler::endScope() {
+    if (!enabled || openMarkers.empty()) {
+        return;
+    }
+    slots[current].markers[openMarkers.back()].end = takeQuery();
+    openMarkers.pop_back();
+}
+
+void GpuProfiler::nextFrame() {
+    if (!enabled) {
+        return;
+    }
+    // Scopes left open at the end of the frame end here
+    while (!openMarkers.empty()) {
+        endScope();
+    }
+
+    // The next slot holds the oldest recorded frame; collect it if the GPU is done with it
+    current = (current + 1) % (int)slots.size();
+    FrameSlot& slot = slots[current];
+    if (!slot.markers.empty()) {
+        GLint available = GL_TRUE;
+        for (const Marker& marker : slot.markers) {
+            glGetQueryObjectiv(marker.end, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                break;
+            }
+        }
+        if (available) {
+            collect(slot);
+        }
+        else {
+            ++lateFrames;
+        }
+    }
+    slot.markers.clear();
+    slot.usedQueries = 0;
+}
+
+void GpuProfiler::collect(FrameSlot& slot) {
+    std::vector<float> totals(scopes.size(), 0.0f);
+    GLuint64 frameBegin = ~(GLuint64)0, frameEnd = 0;
+    for (const Marker& marker : slot.markers) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(marker.begin, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(marker.end, GL_QUERY_RESULT, &end);
+        if (end > begin) {
+            totals[marker.scope] += (float)((end - begin) / 1.0e6);
+        }
+        frameBegin = std::min(frameBegin, begin);
+        frameEnd = std::max(frameEnd, end);
+    }
+    totals[0] = frameEnd > frameBegin ? (float)((frameEnd - frameBegin) / 1.0e6) : 0.0f;
+
+    // Scopes that did not run this frame count as zero, so averages are per frame
+    for (size_t i = 0; i < scopes.size(); ++i) {
+        addSample((int)i, totals[i]);
+    }
+    lastFrameMilliseconds = totals[0];
+    ++collectedFrames;
+}
+
+void GpuProfiler::addSample(int scope, float milliseconds) {
+    ScopeStats& stats = scopes[scope];
+    if ((int)stats.samples.size() < windowFrames) {
+        stats.samples.push_back(milliseconds);
+    }
+    else {
+        stats.samples[stats.next] = milliseconds;
+        stats.next = (stats.next + 1) % windowFrames;
+    }
+}
+
+void GpuProfiler::report() const {
+    if (!enabled) {
+        return;
+    }
+    std::cout << "GPU time per frame over the last " << std::min<long long>(collectedFrames, windowFrames)
+        << " collected frames (" << lateFrames << " late, skipped):" << std::endl;
+    std::cout << "  " << std::left << std::setw(24) << "scope" << std::right
+        << std::setw(10) << "min ms" << std::setw(10) << "avg ms" << std::setw(10) << "p99 ms" << std::endl;
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(3);
+    for (const ScopeStats& stats : scopes) {
+        if (stats.samples.empty()) {
+            continue;
+        }
+        std::vector<float> sorted = stats.samples;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (float sample : sorted) {
+            sum += sample;
+        }
+        size_t p99 = std::min(sorted.size() - 1, (size_t)(sorted.size() * 0.99));
+        std::cout << "  " << std::left << std::setw(24) << stats.name << std::right
+            << std::setw(10) << sorted.front() << std::setw(10) << sum / sorted.size() << std::setw(10) << sorted[p99] << std::endl;
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
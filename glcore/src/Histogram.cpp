@@ -0,0 +1,73 @@
+#include <glcore/Histogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+// 256 sub-buckets per power of two: the upper half of each doubling gets 128 linear steps,
+// one part in 128 or better, which keeps two significant digits
+static const int subBucketBits = 8;
+static const int subBucketCount = 1 << subBucketBits;
+static const int subBucketHalf = subBucketCount / 2;
+
+// Index of the highest set bit
+static int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+HdrHistogram::HdrHistogram(int64_t highest) : highestValue(std::max<int64_t>(highest, subBucketCount)) {
+    int bucketCount = 1;
+    while (((int64_t)subBucketCount << (bucketCount - 1)) <= highestValue) {
+        ++bucketCount;
+    }
+    counts.assign((bucketCount + 1) * subBucketHalf, 0);
+}
+
+int HdrHistogram::countsIndex(int64_t value) const {
+    int bucket = highestBit((uint64_t)value | (subBucketCount - 1)) - (subBucketBits - 1);
+    int subBucket = (int)(value >> bucket);
+    return (bucket + 1) * subBucketHalf + (subBucket - subBucketHalf);
+}
+
+int64_t HdrHistogram::highestEquivalentValue(int index) const {
+    int bucket = index / subBucketHalf - 1;
+    int subBucket = index % subBucketHalf + subBucketHalf;
+    if (bucket < 0) {
+        bucket = 0;
+        subBucket -= subBucketHalf;
+    }
+    return ((int64_t)subBucket << bucket) + ((int64_t)1 << bucket) - 1;
+}
+
+void HdrHistogram::record(int64_t value) {
+    value = std::min(std::max<int64_t>(value, 0), highestValue);
+    ++counts[countsIndex(value)];
+    ++count;
+    sum += value;
+    maxValue = std::max(maxValue, value);
+}
+
+void HdrHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    count = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+int64_t HdrHistogram::getPercentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    int64_t target = std::max<int64_t>(1, (int64_t)std::ceil(std::min(percent, 100.0) / 100.0 * count));
+    int64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(highestEquivalentValue((int)i), maxValue);
+        }
+    }
+    return maxValue;
+}
@@ -0,0 +1,28 @@
+#include <glcore/Instancing.h>
+
+#include <glcore/Mat4.h>
+#include <glcore/StateCache.h>
+
+void bindInstanceTransforms(GLuint buffer, GLintptr offset) {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint location = instanceTransformLocation + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(Mat4), (void*)(offset + column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+void bindInstanceColors(GLuint buffer, GLintptr offset) {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(instanceColorLocation, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)offset);
+    glEnableVertexAttribArray(instanceColorLocation);
+    glVertexAttribDivisor(instanceColorLocation, 1);
+}
+
+void bindInstanceCircles(GLuint buffer, GLintptr offset) {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(instanceCircleLocation, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)offset);
+    glEnableVertexAttribArray(instanceCircleLocation);
+    glVertexAttribDivisor(instanceCircleLocation, 1);
+}
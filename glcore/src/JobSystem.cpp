@@ -0,0 +1,130 @@
+#include <glcore/JobSystem.h>
+
+#include <glcore/CpuProfiler.h>
+
+#include <algorithm>
+
+// Deque of the current thread, -1 outside parallelFor and the pool
+static thread_local int currentQueue = -1;
+
+JobSystem::JobSystem(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallelFor(int begin, int end, int grain, const RangeFunction& body) {
+    if (end <= begin) {
+        return;
+    }
+    grain = std::max(grain, 1);
+    if (currentQueue >= 0 || workers.empty() || end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    currentQueue = 0;
+    remainingItems.fetch_add(end - begin, std::memory_order_relaxed);
+    run(0, Job{ &body, begin, end, grain });
+
+    // Help with whatever is left, ours or stolen back, until every item is done
+    while (remainingItems.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (pop(0, job) || steal(0, job)) {
+            run(0, job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    currentQueue = -1;
+}
+
+void JobSystem::push(int queue, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        queues[queue]->jobs.push_back(job);
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        // Taking the lock orders the wake-up after a worker's check of queuedJobs
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::pop(int queue, Job& job) {
+    std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+    if (queues[queue]->jobs.empty()) {
+        return false;
+    }
+    // Newest first: the smallest, most recently split range, still warm in this thread's cache
+    job = queues[queue]->jobs.back();
+    queues[queue]->jobs.pop_back();
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(int thief, Job& job) {
+    int count = (int)queues.size();
+    for (int i = 1; i < count; ++i) {
+        Queue& victim = *queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            // Oldest first: the largest range left, which the thief splits further on its own deque
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::run(int queue, Job job) {
+    while (job.end - job.begin > job.grain) {
+        int middle = job.begin + (job.end - job.begin) / 2;
+        push(queue, Job{ job.body, middle, job.end, job.grain });
+        job.end = middle;
+    }
+    {
+        CpuScope scope("job");
+        (*job.body)(job.begin, job.end);
+    }
+    remainingItems.fetch_sub(job.end - job.begin, std::memory_order_acq_rel);
+}
+
+void JobSystem::workerLoop(int queue) {
+    currentQueue = queue;
+    CpuProfiler::setThreadName("job worker");
+    for (;;) {
+        Job job;
+        if (pop(queue, job) || steal(queue, job)) {
+            run(queue, job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
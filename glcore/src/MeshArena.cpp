@@ -0,0 +1,53 @@
+#include <glcore/MeshArena.h>
+
+#include <glcore/StateCache.h>
+
+MeshArena::~MeshArena() {
+    destroy();
+}
+
+MeshRange MeshArena::addMesh(const GLfloat* positions, int vertexCount, const GLfloat* targets) {
+    MeshRange range;
+    range.firstVertex = getVertexCount();
+    range.vertexCount = vertexCount;
+
+    const GLfloat* morphTargets = targets ? targets : positions;
+    vertices.reserve(vertices.size() + vertexCount * arenaVertexFloats);
+    for (int i = 0; i < vertexCount; ++i) {
+        vertices.insert(vertices.end(), &positions[i * 3], &positions[i * 3] + 3);
+        vertices.insert(vertices.end(), &morphTargets[i * 3], &morphTargets[i * 3] + 3);
+    }
+    return range;
+}
+
+MeshRange MeshArena::addMorphMesh(const std::vector<GLfloat>& interleaved) {
+    MeshRange range;
+    range.firstVertex = getVertexCount();
+    range.vertexCount = (GLsizei)(interleaved.size() / arenaVertexFloats);
+    vertices.insert(vertices.end(), interleaved.begin(), interleaved.end());
+    return range;
+}
+
+void MeshArena::upload() {
+    if (buffer == 0) {
+        glGenBuffers(1, &buffer);
+    }
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
+}
+
+void MeshArena::destroy() {
+    if (buffer) {
+        getStateCache().forgetBuffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+void MeshArena::bindAttributes() const {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, arenaVertexFloats * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, arenaVertexFloats * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+}
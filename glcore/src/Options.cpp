@@ -0,0 +1,154 @@
+#include <glcore/Options.h>
+
+#include <glcore/FrameDump.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Frame count used when running headless without --frames, so a render box never spins forever
+static const int defaultHeadlessFrames = 600;
+
+static bool parseInt(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 0) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+static bool parseSeconds(const char* text, double& value) {
+    char* end = nullptr;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || !(parsed > 0.0)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static bool parseSize(const char* text, int& width, int& height) {
+    if (std::sscanf(text, "%dx%d", &width, &height) != 2) {
+        return false;
+    }
+    return width > 0 && height > 0;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+        << "  --headless         render without a window (surfaceless EGL)\n"
+        << "  --frames N         stop after N frames (headless default " << defaultHeadlessFrames << ")\n"
+        << "  --clock MODE       realtime (default), fixed (1/rate s per frame, paced) or fast\n"
+        << "                     (1/rate s per frame, unpaced, no vsync); fixed and fast are reproducible\n"
+        << "  --clock-rate HZ    frames per second of the fixed and fast clocks (default 60)\n"
+        << "  --size WxH         framebuffer size (default 800x800)\n"
+        << "  --threads N        animate on N threads (default: one per core)\n"
+        << "  --tick-rate HZ     simulation ticks per second (default 60)\n"
+        << "  --instances N      draw N instanced shapes (ShapeTransformations)\n"
+        << "  --circles N        draw a field of N batched circles (ShapeTransformations)\n"
+        << "  --procedural N     draw N shapes generated from gl_VertexID (ShapeTransformations)\n"
+        << "  --orphan           stream dynamic data by orphaning instead of persistent mapping\n"
+        << "  --no-indirect      draw batched scenes one call per shape instead of multi-draw-indirect\n"
+        << "  --render-thread    animate on the main thread and draw on a render thread (--instances)\n"
+        << "  --dump PATTERN     render offscreen and write frames to PATTERN, a printf pattern with exactly\n"
+        << "                     one %d for the frame number (frame_%04d.ppm, or .png with libpng)\n"
+        << "  --dump-every N     dump every Nth frame (default 1)\n"
+        << "  --dump-size WxH    offscreen resolution while dumping (default: --size)\n"
+        << "  --trace PATH       record CPU scopes of every thread and write a Chrome trace JSON on exit\n"
+        << "  --gpu-profile      time the GPU work of each render pass and print min/avg/p99 on exit\n"
+        << "  --stats-interval S print CPU/GPU frame time and present interval p50/p95/p99/max, missed\n"
+        << "                     deadlines and fps every S seconds (fractions allowed)\n"
+        << "  --stats-csv PATH   also write every stats interval as a CSV row (default interval 1 s)\n"
+        << "  --help             show this message\n";
+}
+
+bool parseOptions(int argc, char** argv, AppOptions& options) {
+    bool framesGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        }
+        else if (std::strcmp(arg, "--orphan") == 0) {
+            options.orphanStreams = true;
+        }
+        else if (std::strcmp(arg, "--no-indirect") == 0) {
+            options.indirectDraws = false;
+        }
+        else if (std::strcmp(arg, "--gpu-profile") == 0) {
+            options.gpuProfile = true;
+        }
+        else if (std::strcmp(arg, "--render-thread") == 0) {
+            options.renderThread = true;
+        }
+        else if (std::strcmp(arg, "--frames") == 0 && value && parseInt(value, options.frames)) {
+            framesGiven = true;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--clock") == 0 && value && parseClockMode(value, options.clock)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--clock-rate") == 0 && value && parseInt(value, options.clockRate) && options.clockRate > 0) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && value && parseInt(value, options.threads)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--tick-rate") == 0 && value && parseInt(value, options.tickRate) && options.tickRate > 0) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--instances") == 0 && value && parseInt(value, options.instances)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--circles") == 0 && value && parseInt(value, options.circles)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--procedural") == 0 && value && parseInt(value, options.procedural)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--dump") == 0 && value && isFramePattern(value)) {
+            options.dumpPath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && value) {
+            options.tracePath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--stats-csv") == 0 && value) {
+            options.statsCsv = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--stats-interval") == 0 && value && parseSeconds(value, options.statsInterval)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--dump-every") == 0 && value && parseInt(value, options.dumpEvery) && options.dumpEvery > 0) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--dump-size") == 0 && value && parseSize(value, options.dumpWidth, options.dumpHeight)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--size") == 0 && value && parseSize(value, options.width, options.height)) {
+            ++i;
+        }
+        else {
+            if (std::strcmp(arg, "--help") != 0) {
+                std::cout << "Unknown or incomplete option: " << arg << std::endl;
+            }
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.statsCsv && options.statsInterval <= 0.0) {
+        options.statsInterval = 1.0;
+    }
+    if (options.headless && !framesGiven) {
+        options.frames = defaultHeadlessFrames;
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#include <glcore/Procedural.h>
+
+#include <glcore/StateCache.h>
+
+#include <cstddef>
+
+void bindProceduralShapes(GLuint buffer, GLintptr offset) {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(proceduralShapeLocation, 4, GL_FLOAT, GL_FALSE, sizeof(ProceduralShape), (void*)offset);
+    glVertexAttribPointer(proceduralColorLocation, 4, GL_FLOAT, GL_FALSE, sizeof(ProceduralShape),
+        (void*)(offset + offsetof(ProceduralShape, color)));
+    glVertexAttribPointer(proceduralParamsLocation, 2, GL_FLOAT, GL_FALSE, sizeof(ProceduralShape),
+        (void*)(offset + offsetof(ProceduralShape, segments)));
+    for (GLuint location = proceduralShapeLocation; location <= proceduralParamsLocation; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+}
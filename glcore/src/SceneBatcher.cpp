@@ -0,0 +1,147 @@
+#include <glcore/SceneBatcher.h>
+
+#include <glcore/Extensions.h>
+#include <glcore/GpuProfiler.h>
+#include <glcore/StateCache.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+SceneBatcher::~SceneBatcher() {
+    destroy();
+}
+
+bool SceneBatcher::create(const MeshArena& arena, int draws, bool allowPersistent, bool allowIndirect) {
+    destroy();
+    maxDraws = draws;
+    indirect = allowIndirect && getExtensions().multiDrawIndirect;
+
+    GLsizeiptr capacity = maxDraws * (sizeof(DrawRecord) + sizeof(DrawArraysIndirectCommand)) + 16;
+    if (!stream.create(capacity, 3, allowPersistent)) {
+        return false;
+    }
+    records.reserve(maxDraws);
+    this->draws.reserve(maxDraws);
+
+    StateCache& state = getStateCache();
+    glGenVertexArrays(1, &vertexArray);
+    state.bindVertexArray(vertexArray);
+    arena.bindAttributes();
+    for (GLuint location = batchTransformLocation; location <= batchMorphLocation; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    return true;
+}
+
+void SceneBatcher::destroy() {
+    if (vertexArray) {
+        getStateCache().forgetVertexArray(vertexArray);
+        glDeleteVertexArrays(1, &vertexArray);
+        vertexArray = 0;
+    }
+    stream.destroy();
+    records.clear();
+    draws.clear();
+    modes.clear();
+}
+
+void SceneBatcher::begin() {
+    records.clear();
+    draws.clear();
+    modes.clear();
+}
+
+void SceneBatcher::add(GLenum mode, const MeshRange& mesh, const DrawRecord& record) {
+    if ((int)draws.size() >= maxDraws) {
+        std::cout << "ERROR::SCENE_BATCHER::TOO_MANY_DRAWS (" << maxDraws << ")" << std::endl;
+        return;
+    }
+    if (std::find(modes.begin(), modes.end(), mode) == modes.end()) {
+        modes.push_back(mode);
+    }
+    draws.push_back({ mode, mesh, (int)records.size() });
+    records.push_back(record);
+}
+
+void SceneBatcher::bindRecords(GLintptr offset) {
+    getStateCache().bindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(batchTransformLocation + column, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRecord),
+            (void*)(offset + column * 4 * sizeof(float)));
+    }
+    glVertexAttribPointer(batchColorLocation, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRecord), (void*)(offset + offsetof(DrawRecord, color)));
+    glVertexAttribPointer(batchMorphLocation, 1, GL_FLOAT, GL_FALSE, sizeof(DrawRecord), (void*)(offset + offsetof(DrawRecord, morph)));
+}
+
+// GPU profiler scope of a primitive group
+static const char* groupScopeName(GLenum mode) {
+    switch (mode) {
+    case GL_TRIANGLES: return "batch triangles";
+    case GL_TRIANGLE_FAN: return "batch triangle fans";
+    case GL_TRIANGLE_STRIP: return "batch triangle strips";
+    case GL_LINE_LOOP: return "batch line loops";
+    case GL_LINES: return "batch lines";
+    default: return "batch other";
+    }
+}
+
+bool SceneBatcher::submit() {
+    submissions = 0;
+    if (draws.empty()) {
+        return true;
+    }
+
+    // Group by primitive type; records are written in draw order so baseInstance is the position
+    std::stable_sort(draws.begin(), draws.end(), [this](const PendingDraw& a, const PendingDraw& b) {
+        return std::find(modes.begin(), modes.end(), a.mode) < std::find(modes.begin(), modes.end(), b.mode);
+    });
+
+    stream.beginFrame();
+    GLintptr recordOffset = 0, commandOffset = 0;
+    DrawRecord* recordData = (DrawRecord*)stream.allocate(draws.size() * sizeof(DrawRecord), recordOffset);
+    DrawArraysIndirectCommand* commands = (DrawArraysIndirectCommand*)stream.allocate(
+        draws.size() * sizeof(DrawArraysIndirectCommand), commandOffset, sizeof(GLuint));
+    if (recordData == nullptr || commands == nullptr) {
+        std::cout << "ERROR::SCENE_BATCHER::STREAM_FULL (" << draws.size() << " draws)" << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < draws.size(); ++i) {
+        std::memcpy(&recordData[i], &records[draws[i].record], sizeof(DrawRecord));
+        commands[i].count = draws[i].mesh.vertexCount;
+        commands[i].instanceCount = 1;
+        commands[i].first = draws[i].mesh.firstVertex;
+        commands[i].baseInstance = (GLuint)i;
+    }
+    stream.flush();
+
+    StateCache& state = getStateCache();
+    state.bindVertexArray(vertexArray);
+    if (indirect) {
+        bindRecords(recordOffset);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, stream.getBuffer());
+        size_t first = 0;
+        while (first < draws.size()) {
+            size_t last = first;
+            while (last < draws.size() && draws[last].mode == draws[first].mode) {
+                ++last;
+            }
+            const void* start = (const void*)(commandOffset + first * sizeof(DrawArraysIndirectCommand));
+            GpuScope scope(groupScopeName(draws[first].mode));
+            getExtensions().multiDrawArraysIndirectProc(draws[first].mode, start, (GLsizei)(last - first), 0);
+            ++submissions;
+            first = last;
+        }
+    }
+    else {
+        for (size_t i = 0; i < draws.size(); ++i) {
+            bindRecords(recordOffset + i * sizeof(DrawRecord));
+            GpuScope scope(groupScopeName(draws[i].mode));
+            glDrawArrays(draws[i].mode, draws[i].mesh.firstVertex, draws[i].mesh.vertexCount);
+            ++submissions;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,115 @@
+#include <glcore/StateCache.h>
+
+static StateCache stateCache;
+
+StateCache& getStateCache() {
+    return stateCache;
+}
+
+bool StateCache::count(bool skip) {
+    if (skip) {
+        ++stats.skipped;
+    }
+    else {
+        ++stats.issued;
+    }
+    return skip;
+}
+
+int StateCache::bufferSlot(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER: return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return 1;
+    case GL_UNIFORM_BUFFER: return 2;
+    default: return -1;
+    }
+}
+
+void StateCache::useProgram(GLuint newProgram) {
+    if (count(program == newProgram)) {
+        return;
+    }
+    glUseProgram(newProgram);
+    program = newProgram;
+}
+
+void StateCache::bindVertexArray(GLuint newVertexArray) {
+    if (count(vertexArray == newVertexArray)) {
+        return;
+    }
+    glBindVertexArray(newVertexArray);
+    vertexArray = newVertexArray;
+    buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = unknown;
+}
+
+void StateCache::bindBuffer(GLenum target, GLuint buffer) {
+    int slot = bufferSlot(target);
+    if (count(slot >= 0 && buffers[slot] == buffer)) {
+        return;
+    }
+    glBindBuffer(target, buffer);
+    if (slot >= 0) {
+        buffers[slot] = buffer;
+    }
+}
+
+void StateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    bool tracked = target == GL_UNIFORM_BUFFER && index < 8;
+    if (tracked) {
+        const BufferRange& range = uniformRanges[index];
+        if (count(range.buffer == buffer && range.offset == offset && range.size == size)) {
+            return;
+        }
+    }
+    else {
+        count(false);
+    }
+    glBindBufferRange(target, index, buffer, offset, size);
+
+    // The indexed bind also replaces the generic binding of the target
+    int slot = bufferSlot(target);
+    if (slot >= 0) {
+        buffers[slot] = buffer;
+    }
+    if (tracked) {
+        uniformRanges[index] = { buffer, offset, size };
+    }
+}
+
+void StateCache::invalidate() {
+    program = unknown;
+    vertexArray = unknown;
+    for (GLuint& buffer : buffers) {
+        buffer = unknown;
+    }
+    for (BufferRange& range : uniformRanges) {
+        range = { unknown, 0, 0 };
+    }
+}
+
+void StateCache::forgetVertexArray(GLuint deleted) {
+    if (vertexArray == deleted) {
+        vertexArray = unknown;
+        buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = unknown;
+    }
+}
+
+void StateCache::forgetBuffer(GLuint deleted) {
+    for (GLuint& buffer : buffers) {
+        if (buffer == deleted) {
+            buffer = unknown;
+        }
+    }
+    for (BufferRange& range : uniformRanges) {
+        if (range.buffer == deleted) {
+            range = { unknown, 0, 0 };
+        }
+    }
+}
+
+void StateCache::invalidateBuffer(GLenum target) {
+    int slot = bufferSlot(target);
+    if (slot >= 0) {
+        buffers[slot] = unknown;
+    }
+}
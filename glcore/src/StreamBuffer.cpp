@@ -0,0 +1,149 @@
+#include <glcore/StreamBuffer.h>
+
+#include <glcore/Extensions.h>
+#include <glcore/StateCache.h>
+
+#include <cstring>
+#include <iostream>
+
+// Fences are waited on in slices of this many nanoseconds until they signal
+static const GLuint64 fenceWaitSlice = 100000000;
+
+StreamBuffer::~StreamBuffer() {
+    destroy();
+}
+
+bool StreamBuffer::create(GLsizeiptr capacity, int regions, bool allowPersistent) {
+    destroy();
+    if (capacity <= 0 || regions < 1 || regions > (int)(sizeof(fences) / sizeof(fences[0]))) {
+        std::cout << "ERROR::STREAM_BUFFER::INVALID_SIZE" << std::endl;
+        return false;
+    }
+    // Whole 256-byte blocks keep every region start aligned for any attribute or uniform block
+    frameCapacity = (capacity + 255) / 256 * 256;
+    regionCount = regions;
+    persistent = allowPersistent && getExtensions().bufferStorage;
+
+    // GL_COPY_WRITE_BUFFER keeps the array and element bindings of the caller's VAO untouched
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        getExtensions().bufferStorageProc(GL_COPY_WRITE_BUFFER, frameCapacity * regionCount, nullptr, flags);
+        mapped = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, frameCapacity * regionCount, flags);
+        if (mapped == nullptr) {
+            std::cout << "ERROR::STREAM_BUFFER::MAP_FAILED" << std::endl;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            destroy();
+            return false;
+        }
+    }
+    else {
+        // Orphaning reuses one region; the driver keeps the old storage alive while it is read
+        regionCount = 1;
+        glBufferData(GL_COPY_WRITE_BUFFER, frameCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+void StreamBuffer::destroy() {
+    for (GLsync& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (buffer) {
+        if (mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        getStateCache().forgetBuffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    mapped = nullptr;
+    region = -1;
+    used = 0;
+    stats = StreamStats();
+}
+
+void StreamBuffer::beginFrame() {
+    if (buffer == 0) {
+        return;
+    }
+    flush();
+    stats.frameBytes = 0;
+    stats.frameWaits = 0;
+    used = 0;
+
+    if (persistent) {
+        // Everything issued since the last beginFrame() may read the previous region
+        if (region >= 0) {
+            fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        region = (region + 1) % regionCount;
+
+        GLsync& fence = fences[region];
+        if (fence) {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                ++stats.frameWaits;
+                ++stats.totalWaits;
+                do {
+                    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceWaitSlice);
+                } while (result == GL_TIMEOUT_EXPIRED);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    else {
+        region = 0;
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, frameCapacity, nullptr, GL_STREAM_DRAW);
+        mapped = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, frameCapacity, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    ++stats.frames;
+}
+
+void* StreamBuffer::allocate(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment) {
+    if (mapped == nullptr || region < 0) {
+        return nullptr;
+    }
+    GLsizeiptr start = (used + alignment - 1) / alignment * alignment;
+    if (start + size > frameCapacity) {
+        std::cout << "ERROR::STREAM_BUFFER::FRAME_FULL (" << size << " bytes requested)" << std::endl;
+        return nullptr;
+    }
+    used = start + size;
+    stats.frameBytes += size;
+    stats.totalBytes += size;
+
+    GLintptr regionStart = persistent ? region * frameCapacity : 0;
+    offset = regionStart + start;
+    return mapped + offset;
+}
+
+GLintptr StreamBuffer::upload(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+    GLintptr offset = 0;
+    void* target = allocate(size, offset, alignment);
+    if (target == nullptr) {
+        return -1;
+    }
+    std::memcpy(target, data, size);
+    return offset;
+}
+
+void StreamBuffer::flush() {
+    // Coherent persistent mappings need no flush; the orphaned mapping must be released to draw
+    if (!persistent && mapped) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        mapped = nullptr;
+    }
+}
@@ -0,0 +1,32 @@
+#include <glcore/Transform.h>
+
+#include <cmath>
+
+void createRotationMatrix(float* matrix, float angle) {
+    float rad = angle * 3.14159f / 180.0f;
+    float cosA = std::cos(rad);
+    float sinA = std::sin(rad);
+
+    matrix[0] = cosA; matrix[1] = -sinA; matrix[2] = 0.0f; matrix[3] = 0.0f;
+    matrix[4] = sinA; matrix[5] = cosA;  matrix[6] = 0.0f; matrix[7] = 0.0f;
+    matrix[8] = 0.0f; matrix[9] = 0.0f;  matrix[10] = 1.0f; matrix[11] = 0.0f;
+    matrix[12] = 0.0f; matrix[13] = 0.0f; matrix[14] = 0.0f; matrix[15] = 1.0f;
+}
+
+void createTranslationMatrix(float* matrix, float x, float y, float z) {
+    matrix[0] = 1.0f; matrix[1] = 0.0f; matrix[2] = 0.0f; matrix[3] = x;
+    matrix[4] = 0.0f; matrix[5] = 1.0f; matrix[6] = 0.0f; matrix[7] = y;
+    matrix[8] = 0.0f; matrix[9] = 0.0f; matrix[10] = 1.0f; matrix[11] = z;
+    matrix[12] = 0.0f; matrix[13] = 0.0f; matrix[14] = 0.0f; matrix[15] = 1.0f;
+}
+
+void multiplyMatrices(const float* a, const float* b, float* result) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] +
+                a[i * 4 + 1] * b[1 * 4 + j] +
+                a[i * 4 + 2] * b[2 * 4 + j] +
+                a[i * 4 + 3] * b[3 * 4 + j];
+        }
+    }
+}
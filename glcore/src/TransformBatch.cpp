@@ -0,0 +1,227 @@
+#include <glcore/TransformBatch.h>
+
+#include <cmath>
+
+#if defined(GLCORE_MAT4_SSE)
+#include <emmintrin.h>
+#endif
+#if defined(GLCORE_MAT4_AVX) && defined(__AVX2__)
+#define GLCORE_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+void TransformBatch::resize(int count) {
+    x.resize(count, 0.0f);
+    y.resize(count, 0.0f);
+    angle.resize(count, 0.0f);
+    scale.resize(count, 1.0f);
+}
+
+// Cephes single precision sin/cos: reduce to [-pi/4, pi/4] by octant with a three-part pi/4,
+// then evaluate both minimax polynomials and pick per lane.
+static const float fourOverPi = 1.27323954473516f;
+static const float reduce1 = 0.78515625f;
+static const float reduce2 = 2.4187564849853515625e-4f;
+static const float reduce3 = 3.77489497744594108e-8f;
+static const float sinP0 = -1.9515295891e-4f;
+static const float sinP1 = 8.3321608736e-3f;
+static const float sinP2 = -1.6666654611e-1f;
+static const float cosP0 = 2.443315711809948e-5f;
+static const float cosP1 = -1.388731625493765e-3f;
+static const float cosP2 = 4.166664568298827e-2f;
+
+// 2*pi in the same three parts as pi/4 above, for wrapping radians before the octant reduction
+static const float inverseTwoPi = 0.159154943091895f;
+static const float twoPi1 = reduce1 * 8.0f;
+static const float twoPi2 = reduce2 * 8.0f;
+static const float twoPi3 = reduce3 * 8.0f;
+
+// Matches degreesToRadians
+static const float radiansPerDegree = 3.14159f / 180.0f;
+
+#if defined(GLCORE_MAT4_SSE)
+
+static inline void sinCos4(__m128 x, __m128& s, __m128& c) {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+
+    __m128 signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    // Octant, rounded up to even
+    __m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(fourOverPi)));
+    octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(octant);
+
+    __m128 swapSignSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+    __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+        _mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    signSin = _mm_xor_ps(signSin, swapSignSin);
+
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(reduce1)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(reduce2)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(reduce3)));
+    __m128 z = _mm_mul_ps(x, x);
+
+    __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(cosP0), z), _mm_set1_ps(cosP1));
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(cosP2));
+    cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+    cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+    __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sinP0), z), _mm_set1_ps(sinP1));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(sinP2));
+    sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+    __m128 sinResult = _mm_or_ps(_mm_and_ps(polyMask, sinPoly), _mm_andnot_ps(polyMask, cosPoly));
+    __m128 cosResult = _mm_or_ps(_mm_and_ps(polyMask, cosPoly), _mm_andnot_ps(polyMask, sinPoly));
+    s = _mm_xor_ps(sinResult, signSin);
+    c = _mm_xor_ps(cosResult, signCos);
+}
+
+// Wraps degrees into [-180, 180] so the radian reduction stays accurate as animation angles grow
+static inline __m128 wrapDegrees4(__m128 degrees) {
+    __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(1.0f / 360.0f))));
+    return _mm_sub_ps(degrees, _mm_mul_ps(turns, _mm_set1_ps(360.0f)));
+}
+
+// Wraps radians into [-pi, pi]: the octant reduction of sinCos4 loses accuracy on large inputs
+static inline __m128 wrapRadians4(__m128 radians) {
+    __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(radians, _mm_set1_ps(inverseTwoPi))));
+    radians = _mm_sub_ps(radians, _mm_mul_ps(turns, _mm_set1_ps(twoPi1)));
+    radians = _mm_sub_ps(radians, _mm_mul_ps(turns, _mm_set1_ps(twoPi2)));
+    return _mm_sub_ps(radians, _mm_mul_ps(turns, _mm_set1_ps(twoPi3)));
+}
+
+#endif
+
+#if defined(GLCORE_BATCH_AVX2)
+
+static inline void sinCos8(__m256 x, __m256& s, __m256& c) {
+    const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32((int)0x80000000));
+
+    __m256 signSin = _mm256_and_ps(x, signMask);
+    x = _mm256_andnot_ps(signMask, x);
+
+    __m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(fourOverPi)));
+    octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    __m256 y = _mm256_cvtepi32_ps(octant);
+
+    __m256 swapSignSin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29));
+    __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(
+        _mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+    __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+    signSin = _mm256_xor_ps(signSin, swapSignSin);
+
+    x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(reduce1)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(reduce2)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(reduce3)));
+    __m256 z = _mm256_mul_ps(x, x);
+
+    __m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(cosP0), z), _mm256_set1_ps(cosP1));
+    cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(cosP2));
+    cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+    cosPoly = _mm256_sub_ps(cosPoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+    cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+    __m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(sinP0), z), _mm256_set1_ps(sinP1));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(sinP2));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x), x);
+
+    s = _mm256_xor_ps(_mm256_blendv_ps(cosPoly, sinPoly, polyMask), signSin);
+    c = _mm256_xor_ps(_mm256_blendv_ps(sinPoly, cosPoly, polyMask), signCos);
+}
+
+static inline __m256 wrapDegrees8(__m256 degrees) {
+    __m256 turns = _mm256_round_ps(_mm256_mul_ps(degrees, _mm256_set1_ps(1.0f / 360.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return _mm256_sub_ps(degrees, _mm256_mul_ps(turns, _mm256_set1_ps(360.0f)));
+}
+
+static inline __m256 wrapRadians8(__m256 radians) {
+    __m256 turns = _mm256_round_ps(_mm256_mul_ps(radians, _mm256_set1_ps(inverseTwoPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    radians = _mm256_sub_ps(radians, _mm256_mul_ps(turns, _mm256_set1_ps(twoPi1)));
+    radians = _mm256_sub_ps(radians, _mm256_mul_ps(turns, _mm256_set1_ps(twoPi2)));
+    return _mm256_sub_ps(radians, _mm256_mul_ps(turns, _mm256_set1_ps(twoPi3)));
+}
+
+#endif
+
+void sinCos(const float* radians, float* sines, float* cosines, int count) {
+    int i = 0;
+#if defined(GLCORE_BATCH_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        __m256 s, c;
+        sinCos8(wrapRadians8(_mm256_loadu_ps(radians + i)), s, c);
+        _mm256_storeu_ps(sines + i, s);
+        _mm256_storeu_ps(cosines + i, c);
+    }
+#endif
+#if defined(GLCORE_MAT4_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 s, c;
+        sinCos4(wrapRadians4(_mm_loadu_ps(radians + i)), s, c);
+        _mm_storeu_ps(sines + i, s);
+        _mm_storeu_ps(cosines + i, c);
+    }
+#endif
+    for (; i < count; ++i) {
+        sines[i] = std::sin(radians[i]);
+        cosines[i] = std::cos(radians[i]);
+    }
+}
+
+void computeTransforms(const TransformBatch& batch, Mat4* out, int begin, int end) {
+    const float* x = batch.x.data();
+    const float* y = batch.y.data();
+    const float* angle = batch.angle.data();
+    const float* scale = batch.scale.data();
+
+    int i = begin;
+#if defined(GLCORE_MAT4_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 row2 = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+    const __m128 row3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+
+    auto writeFour = [&](int first, __m128 s, __m128 c) {
+        __m128 scales = _mm_loadu_ps(scale + first);
+        c = _mm_mul_ps(c, scales);
+        s = _mm_mul_ps(s, scales);
+
+        // Rows 0 and 1 of four matrices at once: transpose (c, -s, 0, x) and (s, c, 0, y)
+        __m128 r0a = c, r0b = _mm_xor_ps(s, signMask), r0c = zero, r0d = _mm_loadu_ps(x + first);
+        __m128 r1a = s, r1b = c, r1c = zero, r1d = _mm_loadu_ps(y + first);
+        _MM_TRANSPOSE4_PS(r0a, r0b, r0c, r0d);
+        _MM_TRANSPOSE4_PS(r1a, r1b, r1c, r1d);
+
+        __m128 rows0[4] = { r0a, r0b, r0c, r0d };
+        __m128 rows1[4] = { r1a, r1b, r1c, r1d };
+        for (int k = 0; k < 4; ++k) {
+            float* m = out[first + k].m;
+            _mm_store_ps(m + 0, rows0[k]);
+            _mm_store_ps(m + 4, rows1[k]);
+            _mm_store_ps(m + 8, row2);
+            _mm_store_ps(m + 12, row3);
+        }
+    };
+
+#if defined(GLCORE_BATCH_AVX2)
+    for (; i + 8 <= end; i += 8) {
+        __m256 radians = _mm256_mul_ps(wrapDegrees8(_mm256_loadu_ps(angle + i)), _mm256_set1_ps(radiansPerDegree));
+        __m256 s, c;
+        sinCos8(radians, s, c);
+        writeFour(i, _mm256_castps256_ps128(s), _mm256_castps256_ps128(c));
+        writeFour(i + 4, _mm256_extractf128_ps(s, 1), _mm256_extractf128_ps(c, 1));
+    }
+#endif
+    for (; i + 4 <= end; i += 4) {
+        __m128 radians = _mm_mul_ps(wrapDegrees4(_mm_loadu_ps(angle + i)), _mm_set1_ps(radiansPerDegree));
+        __m128 s, c;
+        sinCos4(radians, s, c);
+        writeFour(i, s, c);
+    }
+#endif
+    for (; i < end; ++i) {
+        out[i] = compose(x[i], y[i], 0.0f, std::remainder(angle[i], 360.0f), scale[i]);
+    }
+}
@@ -0,0 +1,68 @@
+#include <glcore/UniformBlocks.h>
+
+#include <glcore/StateCache.h>
+
+#include <iostream>
+
+static_assert(sizeof(FrameUniforms) == 96, "FrameUniforms must match the std140 FrameData block");
+static_assert(sizeof(DrawUniforms) == 96, "DrawUniforms must match the std140 DrawData block");
+
+void bindUniformBlocks(GLuint program) {
+    GLuint frameIndex = glGetUniformBlockIndex(program, "FrameData");
+    if (frameIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, frameIndex, frameBlockBinding);
+    }
+    GLuint drawIndex = glGetUniformBlockIndex(program, "DrawData");
+    if (drawIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, drawIndex, drawBlockBinding);
+    }
+}
+
+static GLsizeiptr alignUp(GLsizeiptr size, GLsizeiptr alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+bool UniformStream::create(int draws, bool allowPersistent, GLint minAlignment) {
+    GLint offsetAlignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    alignment = offsetAlignment > 16 ? offsetAlignment : 16;
+    if (alignment < minAlignment) {
+        alignment = minAlignment;
+    }
+    frameStride = alignUp(sizeof(FrameUniforms), alignment);
+    drawStride = alignUp(sizeof(DrawUniforms), alignment);
+    maxDraws = draws;
+    return stream.create(frameStride + drawStride * maxDraws, 3, allowPersistent);
+}
+
+void UniformStream::destroy() {
+    stream.destroy();
+    frame = nullptr;
+    draws = nullptr;
+}
+
+bool UniformStream::beginFrame(int drawCount) {
+    if (drawCount > maxDraws) {
+        std::cout << "ERROR::UNIFORM_STREAM::TOO_MANY_DRAWS (" << drawCount << " > " << maxDraws << ")" << std::endl;
+        return false;
+    }
+    stream.beginFrame();
+    frame = (FrameUniforms*)stream.allocate(frameStride, frameOffset, alignment);
+    // Scenes created with maxDraws 0 only use the frame block; no draw region was reserved for them
+    if (drawCount == 0) {
+        draws = nullptr;
+        drawOffset = 0;
+        return frame != nullptr;
+    }
+    draws = (char*)stream.allocate(drawStride * drawCount, drawOffset, alignment);
+    return frame != nullptr && draws != nullptr;
+}
+
+void UniformStream::flush() {
+    stream.flush();
+    getStateCache().bindBufferRange(GL_UNIFORM_BUFFER, frameBlockBinding, stream.getBuffer(), frameOffset, sizeof(FrameUniforms));
+}
+
+void UniformStream::bindDraw(int index) {
+    getStateCache().bindBufferRange(GL_UNIFORM_BUFFER, drawBlockBinding, stream.getBuffer(), drawOffset + index * drawStride, sizeof(DrawUniforms));
+}
@@ -0,0 +1,112 @@
+// Compares a rendered frame with its reference image for the golden tests (see RunGolden.cmake).
+//
+//   golden_compare REFERENCE ACTUAL DIFF [TOLERANCE] [MAX_BAD_FRACTION]
+//
+// A pixel is bad when any channel differs by more than TOLERANCE (default 8 of 255), which
+// absorbs rasterizer rounding between llvmpipe builds. The images match when at most
+// MAX_BAD_FRACTION of the pixels (default 0.002) are bad. DIFF receives a PPM of the reference
+// dimmed to a third with the bad pixels in red, written whether or not the images match.
+// A reference of one solid color is rejected: it would only prove that the frame was cleared.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels; // RGB, top row first
+};
+
+// Reads a binary PPM with 8-bit channels (what FrameDumper writes)
+static bool readPPM(const char* path, Image& image) {
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        std::cout << "Cannot open " << path << std::endl;
+        return false;
+    }
+    int maxValue = 0;
+    bool ok = std::fscanf(file, "P6 %d %d %d", &image.width, &image.height, &maxValue) == 3
+        && maxValue == 255 && image.width > 0 && image.height > 0 && std::fgetc(file) != EOF;
+    if (ok) {
+        image.pixels.resize((size_t)image.width * image.height * 3);
+        ok = std::fread(image.pixels.data(), 1, image.pixels.size(), file) == image.pixels.size();
+    }
+    std::fclose(file);
+    if (!ok) {
+        std::cout << path << " is not an 8-bit binary PPM" << std::endl;
+    }
+    return ok;
+}
+
+static bool isSolid(const Image& image) {
+    for (size_t i = 3; i < image.pixels.size(); ++i) {
+        if (image.pixels[i] != image.pixels[i % 3]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool writePPM(const char* path, const Image& image) {
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", image.width, image.height);
+    bool ok = std::fwrite(image.pixels.data(), 1, image.pixels.size(), file) == image.pixels.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cout << "Usage: " << argv[0] << " REFERENCE ACTUAL DIFF [TOLERANCE] [MAX_BAD_FRACTION]" << std::endl;
+        return 2;
+    }
+    int tolerance = argc > 4 ? std::atoi(argv[4]) : 8;
+    double maxBadFraction = argc > 5 ? std::atof(argv[5]) : 0.002;
+
+    Image reference, actual;
+    if (!readPPM(argv[1], reference) || !readPPM(argv[2], actual)) {
+        return 2;
+    }
+    if (reference.width != actual.width || reference.height != actual.height) {
+        std::cout << "Size mismatch: reference " << reference.width << "x" << reference.height
+            << ", actual " << actual.width << "x" << actual.height << std::endl;
+        return 1;
+    }
+
+    if (isSolid(reference)) {
+        std::cout << argv[1] << " is a single color; dump a frame that draws something" << std::endl;
+        return 1;
+    }
+
+    Image diff = reference;
+    long long badPixels = 0;
+    int worst = 0;
+    for (size_t i = 0; i < reference.pixels.size(); i += 3) {
+        int difference = 0;
+        for (int c = 0; c < 3; ++c) {
+            difference = std::max(difference, std::abs(reference.pixels[i + c] - actual.pixels[i + c]));
+        }
+        worst = std::max(worst, difference);
+        bool bad = difference > tolerance;
+        badPixels += bad ? 1 : 0;
+        for (int c = 0; c < 3; ++c) {
+            diff.pixels[i + c] = bad ? (c == 0 ? 255 : 0) : reference.pixels[i + c] / 3;
+        }
+    }
+    if (!writePPM(argv[3], diff)) {
+        std::cout << "Cannot write " << argv[3] << std::endl;
+    }
+
+    long long pixelCount = (long long)reference.width * reference.height;
+    double badFraction = (double)badPixels / pixelCount;
+    bool match = badFraction <= maxBadFraction;
+    std::cout << (match ? "MATCH " : "MISMATCH ") << argv[2] << ": " << badPixels << " of " << pixelCount
+        << " pixels off by more than " << tolerance << " (largest difference " << worst << "), diff in "
+        << argv[3] << std::endl;
+    return match ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+# One golden-image test, run by ctest through cmake -P (see tests/CMakeLists.txt).
+#
+# Renders DEMO headless with the fast virtual clock, so frame N always shows time N/60 s, dumps
+# frames to OUTPUT_DIR and compares each frame in FRAMES with GOLDEN_DIR/<REFERENCE>_<frame>.ppm.
+# Diff images are written next to the dumps as <NAME>_<frame>_diff.ppm.
+#
+# Set GOLDEN_UPDATE=1 in the environment to overwrite the references with this run's frames.
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+file(GLOB previous ${OUTPUT_DIR}/${NAME}_*.ppm)
+if(previous)
+    file(REMOVE ${previous})
+endif()
+
+separate_arguments(demoArgs UNIX_COMMAND "${ARGS}")
+separate_arguments(frames UNIX_COMMAND "${FRAMES}")
+execute_process(
+    COMMAND ${DEMO} --headless --clock fast --size ${SIZE} ${demoArgs} --dump ${OUTPUT_DIR}/${NAME}_%d.ppm
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+)
+message("${output}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${DEMO} exited with ${result}")
+endif()
+
+set(failures "")
+foreach(frame ${frames})
+    set(actual ${OUTPUT_DIR}/${NAME}_${frame}.ppm)
+    set(reference ${GOLDEN_DIR}/${REFERENCE}_${frame}.ppm)
+    if(NOT EXISTS ${actual})
+        list(APPEND failures "frame ${frame} was not dumped")
+    elseif(DEFINED ENV{GOLDEN_UPDATE})
+        execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${actual} ${reference})
+        message("Updated ${reference}")
+    elseif(NOT EXISTS ${reference})
+        list(APPEND failures "no reference ${reference} (rerun with GOLDEN_UPDATE=1 to create it)")
+    else()
+        execute_process(
+            COMMAND ${COMPARE} ${reference} ${actual} ${OUTPUT_DIR}/${NAME}_${frame}_diff.ppm
+            RESULT_VARIABLE result
+        )
+        if(NOT result EQUAL 0)
+            list(APPEND failures "frame ${frame} differs from ${reference}")
+        endif()
+    endif()
+endforeach()
+
+if(failures)
+    string(REPLACE ";" "\n  " failures "${failures}")
+    message(FATAL_ERROR "Golden test ${NAME} failed:\n  ${failures}")
+endif()
@@ -0,0 +1,54 @@
+// Runs UniformStream in a headless context with its blocks aligned to 256 bytes, the
+// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT of most desktop drivers, whatever the driver reports.
+// llvmpipe's smaller alignment leaves slack in every region that hides sizing mistakes.
+
+#include <glcore/Context.h>
+#include <glcore/UniformBlocks.h>
+
+#include <iostream>
+
+static const GLint desktopAlignment = 256;
+
+// Creates a stream for maxDraws blocks and fills drawCount of them for a few frames, enough to
+// go round the ring of regions
+static bool runFrames(int maxDraws, int drawCount) {
+    UniformStream uniforms;
+    if (!uniforms.create(maxDraws, true, desktopAlignment)) {
+        std::cout << "create(" << maxDraws << ") failed" << std::endl;
+        return false;
+    }
+    for (int frame = 0; frame < 8; ++frame) {
+        if (!uniforms.beginFrame(drawCount)) {
+            std::cout << "beginFrame(" << drawCount << ") failed on frame " << frame << " with maxDraws " << maxDraws << std::endl;
+            return false;
+        }
+        uniforms.getFrame().time = (float)frame;
+        for (int i = 0; i < drawCount; ++i) {
+            setColor(uniforms.getDraw(i).color, 1.0f, 0.0f, 0.0f, 1.0f);
+        }
+        uniforms.flush();
+        for (int i = 0; i < drawCount; ++i) {
+            uniforms.bindDraw(i);
+        }
+    }
+    return true;
+}
+
+int main() {
+    AppOptions options;
+    options.headless = true;
+    options.width = 16;
+    options.height = 16;
+    Context context;
+    if (!context.create(options, "uniform_stream_test")) {
+        return 1;
+    }
+
+    // Frame block only, as the scenes that keep their per-draw data elsewhere create it
+    bool ok = runFrames(0, 0);
+    ok = runFrames(1, 0) && ok;
+    ok = runFrames(3, 3) && ok;
+    ok = runFrames(3, 1) && ok;
+    std::cout << (ok ? "UniformStream passed with 256-byte blocks" : "UniformStream failed with 256-byte blocks") << std::endl;
+    return ok ? 0 : 1;
+}